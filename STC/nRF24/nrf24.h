@@ -9,6 +9,8 @@
 #define HIGH 		Bit_SET
 
 #define NRF24_ADDR_LEN 5
+#define NRF24_MAX_PAYLOAD 32
+#define NRF24_PIPES 6
 #define NRF24_CONFIG ((1<<EN_CRC)|(0<<CRCO))
 
 #define NRF24_TRANSMISSON_OK 0
@@ -23,8 +25,13 @@ typedef struct {
 	uint8_t TXAddress[8];
 	uint8_t PayloadSize;
 	uint8_t Channel;
-	uint8_t RXData[32];
-	uint8_t TXData[32];
+	uint8_t Pipes; // bit for each pipe that receives data
+	uint8_t DynamicPayload; // payload length sent with each packet
+	uint8_t RXLength; // length of the payload in RXData
+	uint8_t TXLength; // length of the payload in TXData, if dynamic
+
+	uint8_t RXData[NRF24_MAX_PAYLOAD];
+	uint8_t TXData[NRF24_MAX_PAYLOAD];
 } nrf24_t;
 
 /* Memory Map */
@@ -53,6 +60,7 @@ typedef struct {
 #define RX_PW_P5    0x16
 #define FIFO_STATUS 0x17
 #define DYNPD       0x1C
+#define FEATURE     0x1D
 
 /* Bit Mnemonics */
 
@@ -119,6 +127,11 @@ typedef struct {
 #define DPL_P4      4
 #define DPL_P5      5
 
+/* feature */
+#define EN_DPL      2
+#define EN_ACK_PAY  1
+#define EN_DYN_ACK  0
+
 /* Instruction Mnemonics */
 #define R_REGISTER    0x00 /* last 4 bits will indicate reg. address */
 #define W_REGISTER    0x20 /* last 4 bits will indicate reg. address */
@@ -140,6 +153,7 @@ nrf24_error_t nRF24_Init(void);
 void nRF24_Config(nrf24_t* ctxNRF24);
 uint8_t nRF24_Check(void);
 void NRF24SetRxAddress(nrf24_t* ctxNRF24);
+void NRF24SetPipeAddress(uint8_t Pipe, const uint8_t* Address);
 uint8_t NRF24TxPayloadLength(void);
 void NRF24SetTxAddress(nrf24_t* ctxNRF24);
 uint8_t NRF24DataReady(void);
@@ -156,6 +170,7 @@ void NRF24PowerUpTx(void);
 void NRF24PowerDown(void);
 void NRF24ReceiveBuffer(uint8_t* DataIn, uint8_t Len);
 void NRF24TransmitBuffer(uint8_t* Data, uint8_t Len);
+uint8_t NRF24Command(uint8_t Cmd, const uint8_t* Tx, uint8_t* Rx, uint8_t Len);
 void NRF24ConfigRegister(uint8_t Address, uint8_t Value);
 void NRF24ReadRegister(uint8_t Address, uint8_t* Data, uint8_t Len);
 void NRF24WriteRegister(uint8_t Address, uint8_t* Data, uint8_t Len);
@@ -15,17 +15,25 @@
 #include "nrf24_mid_level.h"
 #include "nrf24_low_level.h"
 #include "nrf24.h"
+#include "packet.h"
 #include "ds1820.h"
 #include "debugUsart.h"
+#include "defines.h"
 
 /* Private variables ---------------------------------------------------------*/
 nrf24_t NRF24Ctx = {
 		.RXAddress = { 0xE7, 0xE7, 0xE7, 0xE7, 0xE7 },
 		.TXAddress = { 0xD7, 0xD7, 0xD7, 0xD7, 0xD7 },
 		.PayloadSize = 2,
-		.Channel = 2
+		.Channel = 2,
+		.Pipes = (1 << 1),
+		.DynamicPayload = true
 };
 
+// Sequence number of the next packet, and if the hub has had one since reset
+static uint8_t m_sequence;
+static uint8_t m_acked;
+
 void nRF24_Initialize(void) {
 	nRF24_GPIO_Init();
 #ifdef USE_SPI1
@@ -50,10 +58,14 @@ void nRF24_Initialize(void) {
 }
 
 void nRF24_Transmit(void) {
-	/* Prepare data for sending */
-	memset(NRF24Ctx.TXData, 0, sizeof(NRF24Ctx.TXData));
-	uint8_t *temp = GetCurrentTemperature(T_COLLECTOR);
-	memcpy(NRF24Ctx.TXData, temp, NRF24Ctx.PayloadSize);
+	/* Prepare data for sending, the hub starts the sequence over on BOOT */
+	packet_t packet;
+	int16_t temperature;
+	memcpy(&temperature, GetCurrentTemperature(T_COLLECTOR), sizeof(temperature));
+	packet_Init(&packet, NRF24_NODE_ID, m_sequence++,
+			m_acked ? 0 : PACKET_STATUS_BOOT);
+	packet_Add(&packet, PACKET_TEMPERATURE, temperature);
+	NRF24Ctx.TXLength = packet_Encode(&packet, NRF24Ctx.TXData);
 
 	Debug_PrintTemperatures();
 
@@ -70,6 +82,7 @@ void nRF24_Transmit(void) {
 	if (sendStatus == NRF24_TRANSMISSON_OK) {
 		debug.printf("Transmition OK!\r\n");
 		ToggleLedInd();
+		m_acked = true;
 	} else if (sendStatus == NRF24_MESSAGE_LOST) {
 		debug.printf("Transmition ERROR!\r\n");
 	}
@@ -14,6 +14,9 @@
 #ifndef __NRF24_MID_LEVEL_H
 #define __NRF24_MID_LEVEL_H
 
+// ID of this node in the packet header, the hub keeps the collector here
+#define NRF24_NODE_ID		1
+
 void nRF24_Initialize(void);
 void nRF24_Transmit(void);
 
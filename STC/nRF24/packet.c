@@ -0,0 +1,121 @@
+/**
+ ******************************************************************************
+ * @file		packet.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Radio payload with a header and a batch of readings.
+ *
+ * A payload starts with the version, the node ID, a sequence number and
+ * the node status, then as many readings as fit in 32 bytes, three bytes
+ * each: the sensor and its value. The payload length is dynamic, so it is
+ * as long as the readings in it, and one packet can carry every sensor of
+ * a node and its battery.
+ *
+ * The sequence number lets the hub drop a packet it has already seen and
+ * count the ones that got lost. A two byte payload is the collector
+ * temperature the STC sent before the header, it is read as version 0.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include "packet.h"
+#include "defines.h"
+
+/** Public functions -------------------------------------------------------- */
+void packet_Init(packet_t *packet, uint8_t node, uint8_t sequence,
+		uint8_t status) {
+	packet->version = PACKET_VERSION;
+	packet->node = node;
+	packet->sequence = sequence;
+	packet->status = status;
+	packet->count = 0;
+}
+
+// Reading into the batch, false if it is full
+uint8_t packet_Add(packet_t *packet, uint8_t sensor, int16_t value) {
+	if (packet->count >= PACKET_MAX_READINGS) {
+		return false;
+	}
+	packet->readings[packet->count].sensor = sensor;
+	packet->readings[packet->count].value = value;
+	packet->count++;
+	return true;
+}
+
+// Payload into out, PACKET_MAX_SIZE bytes at most, returns its length
+uint8_t packet_Encode(const packet_t *packet, uint8_t *out) {
+	uint8_t i, len;
+
+	out[0] = packet->version;
+	out[1] = packet->node;
+	out[2] = packet->sequence;
+	out[3] = packet->status;
+	len = PACKET_HEADER_SIZE;
+	for (i = 0; i < packet->count; i++) {
+		out[len] = packet->readings[i].sensor;
+		out[len + 1] = packet->readings[i].value;
+		out[len + 2] = (uint16_t) packet->readings[i].value >> 8;
+		len += PACKET_READING_SIZE;
+	}
+	return len;
+}
+
+// Payload of len bytes, node of a version 0 packet is left to the caller
+packetError_t packet_Decode(const uint8_t *in, uint8_t len, packet_t *packet) {
+	const uint8_t *reading;
+	uint8_t i;
+
+	if (len == PACKET_LEGACY_SIZE) {
+		packet->version = PACKET_LEGACY_VERSION;
+		packet->node = 0;
+		packet->sequence = 0;
+		packet->status = 0;
+		packet->count = 1;
+		packet->readings[0].sensor = PACKET_TEMPERATURE;
+		packet->readings[0].value = (int16_t) (in[0] | in[1] << 8);
+		return PACKET_OK;
+	}
+
+	if (len < PACKET_HEADER_SIZE) {
+		return PACKET_TOO_SHORT;
+	}
+	if (PACKET_MAJOR(in[0]) != PACKET_MAJOR(PACKET_VERSION)) {
+		return PACKET_WRONG_VERSION;
+	}
+	if (len > PACKET_MAX_SIZE
+			|| (len - PACKET_HEADER_SIZE) % PACKET_READING_SIZE) {
+		return PACKET_BAD_LENGTH;
+	}
+
+	packet->version = in[0];
+	packet->node = in[1];
+	packet->sequence = in[2];
+	packet->status = in[3];
+	packet->count = (len - PACKET_HEADER_SIZE) / PACKET_READING_SIZE;
+	for (i = 0; i < packet->count; i++) {
+		reading = &in[PACKET_HEADER_SIZE + i * PACKET_READING_SIZE];
+		packet->readings[i].sensor = reading[0];
+		packet->readings[i].value = (int16_t) (reading[1] | reading[2] << 8);
+	}
+	return PACKET_OK;
+}
+
+// Readings of one kind into values by their index, a reading of an index
+// past count is left out, values with no reading stay as they are.
+// Returns the readings that were taken.
+uint8_t packet_Values(const packet_t *packet, uint8_t kind, int16_t *values,
+		uint8_t count) {
+	uint8_t i, index, taken = 0;
+
+	for (i = 0; i < packet->count; i++) {
+		index = PACKET_INDEX(packet->readings[i].sensor);
+		if (PACKET_KIND(packet->readings[i].sensor) == kind && index < count) {
+			values[index] = packet->readings[i].value;
+			taken++;
+		}
+	}
+	return taken;
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -19,7 +19,6 @@
 #include "systemTicks.h"
 #include "debugUsart.h"
 #include "nrf24_mid_level.h"
-#include "ssd1306.h"
 
 int16_t m_temperature[2];
 
@@ -147,39 +146,12 @@ void MeasureTemperatures(void) {
 	MeasureTemperature(T_BOILER);
 }
 
-// Get temperature string for printing on LCD
-void GetTemperatureString(int16_t temperature, char *tempString) {
-	// Check if temperature is negative
-	if (temperature < 0) {
-		tempString[0] = '-';
-		temperature *= -1;
-	} else {
-		if (temperature / 100)
-			tempString[0] = (uint16_t) temperature / 100 + '0';
-		else
-			tempString[0] = '+';
-	}
-
-	tempString[1] = ((uint16_t) temperature / 10) % 10 + '0'; // Extract tens digit
-	tempString[2] = (uint16_t) temperature % 10 + '0'; // Extract ones digit
-}
-
-void DisplayTemperatures(void) {
-	char tBoiler[] = "000";
-	char tWaterHeater[] = "000";
-	char tCollector[] = "000";
-	GetTemperatureString(m_temperature[T_BOILER], tBoiler);
-	GetTemperatureString(m_temperature[T_WATER_HEATER], tWaterHeater);
-	GetTemperatureString(m_tCollector.i, tCollector);
-
-	ssd1306_PrintTemperatures(tBoiler, tWaterHeater, tCollector);
-}
-
 void Debug_PrintTemperatures(void) {
 	DebugChangeColorToWHITE();
 	debug.printf("Kotao   : %d\r\n", m_temperature[T_BOILER]);
 	debug.printf("Bojler  : %d\r\n", m_temperature[T_WATER_HEATER]);
-	debug.printf("Kolektor: %d\r\n", m_tCollector.i);
+	debug.printf("Kolektor: %d\r\n",
+			nrf24Nodes[NRF24_NODE_COLLECTOR].temperature[0]);
 	DebugChangeColorToGREEN();
 }
 
@@ -35,7 +35,6 @@ void DS1820_Init(void);
 int16_t OW_ReadTemperature(TempSensor_t tempSensor);
 uint8_t OW_ReadPower(TempSensor_t tempSensor);
 void MeasureTemperatures(void);
-void DisplayTemperatures(void);
 void Debug_PrintTemperatures(void);
 
 #endif	/* __DS1820_H */
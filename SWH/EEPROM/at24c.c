@@ -0,0 +1,133 @@
+/**
+ ******************************************************************************
+ * @file		at24c.c
+ * @author		Milan Rakic
+ * @date		31 March 2019
+ ******************************************************************************
+ */
+
+#include "stm32f10x_i2c.h"
+#include "at24c.h"
+#include "i2c.h"
+#include "defines.h"
+#include "systemTicks.h"
+
+// size, page size, address bytes and write cycle from the datasheets
+static const BlockGeometry_t At24cGeometry[] = {
+	{ "24C04", 0x0200, 0x10, 1, TIME(0.005) },
+	{ "24C08", 0x0400, 0x10, 1, TIME(0.005) },
+	{ "24C16", 0x0800, 0x10, 1, TIME(0.005) },
+	{ "24C32", 0x1000, 0x20, 2, TIME(0.01) },
+	{ "24C64", 0x2000, 0x20, 2, TIME(0.01) },
+	{ "24C128", 0x4000, 0x40, 2, TIME(0.005) },
+	{ "24C256", 0x8000, 0x40, 2, TIME(0.005) },
+	{ "24C512", 0x10000, 0x80, 2, TIME(0.005) },
+	// fram takes any length in one write
+	{ "FM24CL64", 0x2000, 0x2000, 2, 0 },
+	{ "MB85RC256", 0x8000, 0x8000, 2, 0 },
+};
+
+const BlockDevice_t At24cDevice = { &At24cGeometry[AT24C_PART],
+		&at24c_readBytes, &at24c_writeInPage, &at24c_isReady };
+
+// i2c address of the device, with the address bits above the one
+// address byte for the small parts in place of the pins they don't have,
+// one bit on the 24C04, two on the 24C08 and three on the 24C16
+static uint8_t at24c_deviceAddr(uint32_t addr) {
+	const BlockGeometry_t *geometry = &At24cGeometry[AT24C_PART];
+	uint8_t blockMask;
+
+	if (geometry->addressBytes == 1) {
+		blockMask = (geometry->size >> 8) - 1;
+		return ((AT24C_ADDR & ~blockMask) | ((addr >> 8) & blockMask)) << 1;
+	}
+
+	return AT24C_ADDR << 1;
+}
+
+// set the current data address, this is the start of the write command
+// next either send the data to be written, or start a read instead
+static void at24c_setAddr(uint32_t addr) {
+	// signal i2c start
+	i2c_start(I2C2);
+
+	// write i2c address & direction
+	i2c_address_direction(I2C2, at24c_deviceAddr(addr),
+			I2C_Direction_Transmitter);
+
+	// write data address
+	if (At24cGeometry[AT24C_PART].addressBytes == 2)
+		i2c_transmit(I2C2, (uint8_t)(addr >> 8));
+	i2c_transmit(I2C2, (uint8_t)(addr & 0xff));
+}
+
+// read from anywhere
+// sets the address then does a normal read, the eeprom increments the
+// address by itself so any length is read in one transaction
+// returns true to indicate success, false if the device didn't answer
+uint8_t at24c_readBytes(uint32_t addr, uint8_t *data, uint16_t len) {
+	int loop;
+
+	// the transfer waits on every ack, so only start it on a device
+	// that answers
+	if (!i2c_probe(I2C2, at24c_deviceAddr(addr)))
+		return false;
+
+	// set data address, it stays set after stop
+	at24c_setAddr(addr);
+	i2c_stop(I2C2);
+
+	// signal i2c start
+	i2c_start(I2C2);
+
+	// write i2c address & direction
+	i2c_address_direction(I2C2, at24c_deviceAddr(addr),
+			I2C_Direction_Receiver);
+
+	// read bytes
+	for (loop = 0; loop < len; loop++) {
+		if (loop < (len - 1)) {
+			data[loop] = i2c_receive_ack(I2C2);
+		} else {
+			data[loop] = i2c_receive_nack(I2C2);
+		}
+	}
+
+	// signal i2c stop
+	i2c_stop(I2C2);
+
+	return true;
+}
+
+// write within a page
+// note if you try to write past a page boundary the write will
+// wrap back to the start of the same page, blockdev_Write splits
+// the data into pages
+// returns true to indicate success, false if the device didn't answer
+uint8_t at24c_writeInPage(uint32_t addr, const uint8_t *data, uint16_t len) {
+	int loop;
+
+	if (!i2c_probe(I2C2, at24c_deviceAddr(addr)))
+		return false;
+
+	// set data address (includes i2c setup,
+	// so no need to call i2c_master_start here)
+	at24c_setAddr(addr);
+
+	// send the data
+	for (loop = 0; loop < len; loop++) {
+		i2c_transmit(I2C2, data[loop]);
+	}
+
+	// signal i2c stop
+	i2c_stop(I2C2);
+
+	return true;
+}
+
+// check if the last write operation is complete, without blocking
+// by 'acknowledge polling': the eeprom doesn't acknowledge its address
+// while the write cycle is in progress
+uint8_t at24c_isReady(void) {
+	return i2c_probe(I2C2, AT24C_ADDR << 1);
+}
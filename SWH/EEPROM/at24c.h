@@ -0,0 +1,49 @@
+/**
+ ******************************************************************************
+ * @file		at24c.h
+ * @author		Milan Rakic
+ * @date		31 March 2019
+ ******************************************************************************
+ */
+
+#ifndef __AT24C_H__
+#define __AT24C_H__
+
+#include "stm32f10x.h"
+#include "blockdev.h"
+
+// works with the atmel 24c series i2c eeproms from 4Kb up to 512Kb and
+// with the i2c fram parts that use the same protocol
+// the parts up to 16Kb use a one byte address, the bits above it take
+// the place of the last bits in the device i2c address, where those parts
+// have no address pin: A0 isn't an address pin on the 24C04, A0-A1 on the
+// 24C08 and A0-A2 on the 24C16, those bits of AT24C_ADDR are left out
+// the larger ones use a two byte address
+
+// address can be from 0x50-0x57 depending on address pins A0-A2
+#define AT24C_ADDR 0x57
+
+// parts the driver knows
+#define AT24C04		0
+#define AT24C08		1
+#define AT24C16		2
+#define AT24C32		3
+#define AT24C64		4
+#define AT24C128	5
+#define AT24C256	6
+#define AT24C512	7
+#define FM24CL64	8	// 64Kb fram, no write cycle
+#define MB85RC256	9	// 256Kb fram, no write cycle
+
+// part on the board
+#ifndef AT24C_PART
+#define AT24C_PART AT24C32
+#endif
+
+extern const BlockDevice_t At24cDevice;
+
+uint8_t at24c_readBytes(uint32_t addr, uint8_t *data, uint16_t len);
+uint8_t at24c_writeInPage(uint32_t addr, const uint8_t *data, uint16_t len);
+uint8_t at24c_isReady(void);
+
+#endif
@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ * @file		blockdev.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Memory the configuration and the history are kept in.
+ *
+ * A device only reads, writes one page and tells if its write cycle is
+ * over, its geometry says how big it is and how it is written. Splitting
+ * writes into pages and waiting for the write cycle is done here, so the
+ * same code runs on any 24C part, on an FRAM which has no write cycle and
+ * on a block of RAM in a host build.
+ *
+ * A write that doesn't wait starts its first page and keeps the rest, every
+ * blockdev_IsReady that finds the write cycle over starts the next page.
+ * A task only writes when the device is ready and never waits for a write
+ * cycle, the next read or write waits for the rest to be written.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "blockdev.h"
+#include "defines.h"
+#include "systemTicks.h"
+
+/** Private variables ------------------------------------------------------- */
+static const BlockDevice_t *m_device;
+// write cycle started by the last write, not confirmed finished yet
+static uint8_t m_writeBusy;
+static uint32_t m_writeStart;
+// rest of the last write, written one page at a time
+static uint8_t m_pendingData[BLOCKDEV_PENDING_SIZE];
+static uint32_t m_pendingAddr;
+static uint16_t m_pendingOffset;
+static uint16_t m_pendingLen;
+
+/** Private functions ------------------------------------------------------- */
+// Give up on the device answering after twice the longest write cycle
+static uint8_t blockdev_WriteTimeout(void) {
+	return TIMEOUT(m_writeStart, 2 * m_device->geometry->writeCycle);
+}
+
+// Write one page and start its write cycle
+static uint8_t blockdev_WritePage(uint32_t addr, const uint8_t *data,
+		uint16_t len) {
+	if (!m_device->WritePage(addr, data, len)) {
+		return false;
+	}
+	if (m_device->geometry->writeCycle) {
+		m_writeBusy = true;
+		m_writeStart = micros;
+	}
+	return true;
+}
+
+// Next page of the rest of the last write, it always starts on a page
+static uint8_t blockdev_WritePending(void) {
+	uint16_t wlen = m_device->geometry->pageSize;
+
+	if (wlen > m_pendingLen) {
+		wlen = m_pendingLen;
+	}
+	if (!blockdev_WritePage(m_pendingAddr, &m_pendingData[m_pendingOffset],
+			wlen)) {
+		return false;
+	}
+	m_pendingAddr += wlen;
+	m_pendingOffset += wlen;
+	m_pendingLen -= wlen;
+	return true;
+}
+
+/** Public functions -------------------------------------------------------- */
+void blockdev_Init(const BlockDevice_t *device) {
+	m_device = device;
+	m_writeBusy = false;
+	m_pendingLen = 0;
+}
+
+const BlockGeometry_t *blockdev_Geometry(void) {
+	return m_device->geometry;
+}
+
+uint32_t blockdev_Size(void) {
+	return m_device->geometry->size;
+}
+
+// Read from anywhere, any length
+uint8_t blockdev_Read(uint32_t addr, uint8_t *data, uint16_t len) {
+	if (addr + len > m_device->geometry->size) {
+		return false;
+	}
+	// the device doesn't answer until the last write is finished
+	if (!blockdev_WriteWait()) {
+		return false;
+	}
+	return m_device->Read(addr, data, len);
+}
+
+// Write across pages, waiting for each write cycle before the next page,
+// optionally for the last one too. Otherwise the pages after the first one
+// are written by blockdev_IsReady and the next operation waits for them.
+uint8_t blockdev_Write(uint32_t addr, const uint8_t *data, uint16_t len,
+		uint8_t wait) {
+	const BlockGeometry_t *geometry = m_device->geometry;
+	uint16_t wlen;
+
+	if (addr + len > geometry->size) {
+		return false;
+	}
+
+	// bytes available in the starting page
+	wlen = geometry->pageSize - (addr % geometry->pageSize);
+	if (wlen > len) {
+		wlen = len;
+	}
+
+	while (wlen > 0) {
+		if (!blockdev_WriteWait()) {
+			return false;
+		}
+		if (!blockdev_WritePage(addr, data, wlen)) {
+			return false;
+		}
+
+		len -= wlen;
+		addr += wlen;
+		data += wlen;
+		wlen = (len < geometry->pageSize ? len : geometry->pageSize);
+
+		if (!wait && m_writeBusy && len > 0 && len <= BLOCKDEV_PENDING_SIZE) {
+			memcpy(m_pendingData, data, len);
+			m_pendingAddr = addr;
+			m_pendingOffset = 0;
+			m_pendingLen = len;
+			return true;
+		}
+	}
+
+	if (wait) {
+		return blockdev_WriteWait();
+	}
+	return true;
+}
+
+// Check if the last write is complete, without blocking, and start its next
+// page if there is one. A device that still doesn't answer after the
+// timeout isn't ready, it is asked again every time until it does.
+uint8_t blockdev_IsReady(void) {
+	if (m_writeBusy) {
+		if (!m_device->IsReady()) {
+			return false;
+		}
+		m_writeBusy = false;
+	}
+	if (m_pendingLen > 0) {
+		blockdev_WritePending();
+		return false;
+	}
+	return true;
+}
+
+// Wait for the last write to complete, false if the device didn't answer
+uint8_t blockdev_WriteWait(void) {
+	do {
+		while (m_writeBusy) {
+			if (m_device->IsReady()) {
+				m_writeBusy = false;
+				break;
+			}
+			if (blockdev_WriteTimeout()) {
+				return false;
+			}
+		}
+	} while (m_pendingLen > 0 && blockdev_WritePending());
+	return m_pendingLen == 0;
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file		blockdev.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __BLOCKDEV_H
+#define __BLOCKDEV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "stm32f10x.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Most bytes after the first page of a write that go on in the background
+#define BLOCKDEV_PENDING_SIZE		0x80
+
+typedef struct {
+	const char *name;
+	uint32_t size;				// bytes
+	uint16_t pageSize;			// most bytes one write takes, wraps inside
+	uint8_t addressBytes;		// 1 puts the address bits above 8 in the
+								// device address
+	uint32_t writeCycle;		// longest write cycle in us, 0 if there is none
+} BlockGeometry_t;
+
+typedef struct {
+	const BlockGeometry_t *geometry;
+	uint8_t (*Read)(uint32_t addr, uint8_t *data, uint16_t len);
+	uint8_t (*WritePage)(uint32_t addr, const uint8_t *data, uint16_t len);
+	uint8_t (*IsReady)(void);	// write cycle is over, NULL without one
+} BlockDevice_t;
+
+/** Public function prototypes ---------------------------------------------- */
+void blockdev_Init(const BlockDevice_t *device);
+const BlockGeometry_t *blockdev_Geometry(void);
+uint32_t blockdev_Size(void);
+uint8_t blockdev_Read(uint32_t addr, uint8_t *data, uint16_t len);
+uint8_t blockdev_Write(uint32_t addr, const uint8_t *data, uint16_t len,
+		uint8_t wait);
+uint8_t blockdev_IsReady(void);
+uint8_t blockdev_WriteWait(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __BLOCKDEV_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
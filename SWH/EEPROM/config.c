@@ -0,0 +1,275 @@
+/**
+ ******************************************************************************
+ * @file		config.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Parameters as typed key/value entries in the EEPROM.
+ *
+ * Every key has two entry slots of its own, an entry holds the key, a
+ * sequence number, the value and a CRC-16. A change writes only the entry
+ * of its key, to the older slot, so a write cut short leaves the copy
+ * before it. The CRC covers the entry alone, nothing else is read or
+ * checksummed again for a change. At boot all entries are read at once and
+ * the newest valid value of each key is kept in RAM, a value is read from
+ * there after that.
+ *
+ * A value that is missing, torn or out of the range of its key reads as
+ * the default, so a new key needs nothing but a line in the schema. The
+ * schema version is an entry too, when it is older than this firmware the
+ * values are moved over once, the first time from the configuration image
+ * in eeprom.c, or from the image of the first firmware with the deltas and
+ * its ten history records. The version is written after the values it
+ * covers.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "config.h"
+#include "eeprom.h"
+#include "history.h"
+#include "crc16.h"
+#include "defines.h"
+#include "debugUsart.h"
+
+/** Private variables ------------------------------------------------------- */
+static const configSchema_t m_configSchema[CONFIG_KEYS] = {
+	{ "VERSION", CONFIG_UINT8, 0, 0, 255 },
+	{ "DELTA +", CONFIG_UINT8, 3, 1, 10 },
+	{ "DELTA -", CONFIG_UINT8, 1, 0, 9 },
+};
+
+// Fails to build when the slots of every key don't fit in the entries
+typedef char config_KeysFit[CONFIG_KEYS <= CONFIG_MAX_KEYS ? 1 : -1];
+
+// Values each type holds
+static const int32_t m_configTypeMin[] = { 0, -128, 0, -32768, INT32_MIN };
+static const int32_t m_configTypeMax[] = { 255, 127, 65535, 32767, INT32_MAX };
+
+// RAM index, value of each key and where its newest entry is
+static int32_t m_configValue[CONFIG_KEYS];
+static uint8_t m_configSequence[CONFIG_KEYS];
+static uint8_t m_configSlot[CONFIG_KEYS];
+static uint8_t m_configStored[CONFIG_KEYS];		// has a valid entry
+static uint8_t m_configDirty[CONFIG_KEYS];		// value not written yet
+
+/** Private functions ------------------------------------------------------- */
+static uint32_t config_Address(uint8_t key, uint8_t slot) {
+	return CONFIG_START + (key * CONFIG_SLOTS + slot) * CONFIG_ENTRY_SIZE;
+}
+
+static uint8_t config_InRange(uint8_t key, int32_t value) {
+	const configSchema_t *schema = &m_configSchema[key];
+
+	return value >= m_configTypeMin[schema->type]
+			&& value <= m_configTypeMax[schema->type] && value >= schema->min
+			&& value <= schema->max;
+}
+
+static void config_Encode(uint8_t key, uint8_t sequence, int32_t value,
+		uint8_t *entry) {
+	uint16_t crc;
+
+	entry[0] = key;
+	entry[1] = sequence;
+	entry[2] = value;
+	entry[3] = value >> 8;
+	entry[4] = value >> 16;
+	entry[5] = value >> 24;
+	crc = crc16(entry, CONFIG_ENTRY_SIZE - 2);
+	entry[6] = crc & 0xFF;
+	entry[7] = crc >> 8;
+}
+
+// Entry of key, false if it's torn, erased or of another key
+static uint8_t config_Decode(uint8_t key, const uint8_t *entry,
+		uint8_t *sequence, int32_t *value) {
+	if ((entry[6] | entry[7] << 8) != crc16(entry, CONFIG_ENTRY_SIZE - 2)
+			|| entry[0] != key) {
+		return false;
+	}
+	*sequence = entry[1];
+	*value = (int32_t) ((uint32_t) entry[2] | (uint32_t) entry[3] << 8
+			| (uint32_t) entry[4] << 16 | (uint32_t) entry[5] << 24);
+	return true;
+}
+
+// Values from schema version before the current one, in steps
+static void config_Migrate(int32_t version) {
+	EEPROM_Legacy_t legacy;
+	uint8_t i;
+
+	switch (version) {
+	case 0:
+		// Configuration image from before the entries, else the image of
+		// the first firmware with its history. That one is at the start of
+		// the entries, it is read before any of them is written.
+		if (at24c_read()) {
+			config_Set(CONFIG_DELTA_PLUS,
+					m_EEPROM_Array.Payload.Item.deltaPlus);
+			config_Set(CONFIG_DELTA_MINUS,
+					m_EEPROM_Array.Payload.Item.deltaMinus);
+		} else if (at24c_readLegacy(&legacy)) {
+			config_Set(CONFIG_DELTA_PLUS, legacy.deltaPlus);
+			config_Set(CONFIG_DELTA_MINUS, legacy.deltaMinus);
+			history_Mount();
+			for (i = 0; i < legacy.count; i++) {
+				history_Append(&legacy.data[i]);
+			}
+		}
+		/* no break */
+	default:
+		break;
+	}
+}
+
+/** Public functions -------------------------------------------------------- */
+// Build the RAM index from the entries, called once at boot
+void config_Mount(void) {
+	uint8_t image[CONFIG_KEYS * CONFIG_SLOTS * CONFIG_ENTRY_SIZE];
+	uint8_t key, slot, sequence[CONFIG_SLOTS], valid[CONFIG_SLOTS];
+	int32_t value[CONFIG_SLOTS], version;
+
+	memset(m_configStored, false, sizeof(m_configStored));
+	memset(m_configDirty, false, sizeof(m_configDirty));
+	for (key = 0; key < CONFIG_KEYS; key++) {
+		m_configValue[key] = m_configSchema[key].def;
+	}
+
+	// entries of all the keys in one sequential read
+	if (!blockdev_Read(CONFIG_START, image, sizeof(image))) {
+		DebugChangeColorToRED();
+		debug.printf("Config: Error I2C\r\n");
+		DebugChangeColorToGREEN();
+		return;
+	}
+
+	for (key = 0; key < CONFIG_KEYS; key++) {
+		for (slot = 0; slot < CONFIG_SLOTS; slot++) {
+			valid[slot] = config_Decode(key,
+					&image[config_Address(key, slot) - CONFIG_START],
+					&sequence[slot], &value[slot]);
+		}
+		if (!valid[0] && !valid[1]) {
+			continue;
+		}
+
+		// newest valid copy, sequence wraps so compare the difference
+		if (valid[0] && valid[1]) {
+			slot = (int8_t) (sequence[1] - sequence[0]) > 0;
+		} else {
+			slot = valid[1];
+		}
+		m_configStored[key] = true;
+		m_configSequence[key] = sequence[slot];
+		m_configSlot[key] = slot;
+		if (config_InRange(key, value[slot])) {
+			m_configValue[key] = value[slot];
+		} else {
+			debug.printf("Config: %s %d out of range\r\n",
+					m_configSchema[key].name, (int) value[slot]);
+		}
+	}
+
+	version = m_configValue[CONFIG_VERSION];
+	if (version > CONFIG_SCHEMA_VERSION) {
+		debug.printf("Config: schema %d is newer than %d\r\n", (int) version,
+				CONFIG_SCHEMA_VERSION);
+	} else if (version < CONFIG_SCHEMA_VERSION) {
+		config_Migrate(version);
+		if (config_Flush()) {
+			config_Set(CONFIG_VERSION, CONFIG_SCHEMA_VERSION);
+			config_Flush();
+		}
+		debug.printf("Config: schema %d migrated to %d\r\n", (int) version,
+				CONFIG_SCHEMA_VERSION);
+	}
+}
+
+const configSchema_t *config_Schema(uint8_t key) {
+	return &m_configSchema[key];
+}
+
+int32_t config_Get(uint8_t key) {
+	return m_configValue[key];
+}
+
+// New value, written by config_FlushStep, false if it is out of range
+uint8_t config_Set(uint8_t key, int32_t value) {
+	if (key >= CONFIG_KEYS || !config_InRange(key, value)) {
+		return false;
+	}
+	if (m_configValue[key] != value || !m_configStored[key]) {
+		m_configValue[key] = value;
+		m_configDirty[key] = true;
+	}
+	return true;
+}
+
+uint8_t config_Pending(void) {
+	uint8_t key;
+
+	for (key = 0; key < CONFIG_KEYS; key++) {
+		if (m_configDirty[key]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// Write the entry of one changed key, false if it didn't go
+uint8_t config_FlushStep(void) {
+	uint8_t entry[CONFIG_ENTRY_SIZE];
+	uint8_t key, slot, sequence;
+
+	for (key = 0; key < CONFIG_KEYS && !m_configDirty[key]; key++)
+		;
+	if (key == CONFIG_KEYS) {
+		return true;
+	}
+
+	slot = m_configStored[key] ? m_configSlot[key] ^ 1 : 0;
+	sequence = m_configStored[key] ? m_configSequence[key] + 1 : 0;
+	config_Encode(key, sequence, m_configValue[key], entry);
+
+	// entry fits in one page, one write cycle, the next operation waits
+	// for it to finish
+	if (!blockdev_Write(config_Address(key, slot), entry, sizeof(entry),
+			false)) {
+		DebugChangeColorToRED();
+		debug.printf("Config: Error I2C\r\n");
+		DebugChangeColorToGREEN();
+		return false;
+	}
+
+	m_configStored[key] = true;
+	m_configSequence[key] = sequence;
+	m_configSlot[key] = slot;
+	m_configDirty[key] = false;
+	return true;
+}
+
+// Write every changed key now
+uint8_t config_Flush(void) {
+	while (config_Pending()) {
+		if (!config_FlushStep()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void config_Print(void) {
+	const configSchema_t *schema;
+	uint8_t key;
+
+	for (key = 0; key < CONFIG_KEYS; key++) {
+		schema = &m_configSchema[key];
+		debug.printf("%s: %d (%d, %d..%d)%s\r\n", schema->name,
+				(int) m_configValue[key], (int) schema->def, (int) schema->min,
+				(int) schema->max, m_configDirty[key] ? " *" : "");
+	}
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
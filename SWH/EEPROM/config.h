@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @file		config.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __CONFIG_H
+#define __CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "stm32f10x.h"
+#include "blockdev.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Entries after the two copies of the old configuration image, up to the
+// history
+#define CONFIG_START				0x0040
+#define CONFIG_END					0x0100
+
+// Key, sequence, value and CRC-16, two copies of each key next to each
+// other, a write goes to the older one
+#define CONFIG_ENTRY_SIZE			8
+#define CONFIG_SLOTS				2
+#define CONFIG_MAX_KEYS				((CONFIG_END - CONFIG_START) \
+										/ (CONFIG_ENTRY_SIZE * CONFIG_SLOTS))
+
+// Changed when a key changes meaning, config_Mount moves the values over
+#define CONFIG_SCHEMA_VERSION		1
+
+// Never reused, a new key goes at the end
+typedef enum {
+	CONFIG_VERSION = 0,		// schema the entries were written with
+	CONFIG_DELTA_PLUS,		// pump on at this much above the water heater
+	CONFIG_DELTA_MINUS,		// pump off at this much above the water heater
+	CONFIG_KEYS
+} configKey_t;
+
+typedef enum {
+	CONFIG_UINT8 = 0,
+	CONFIG_INT8,
+	CONFIG_UINT16,
+	CONFIG_INT16,
+	CONFIG_INT32
+} configType_t;
+
+typedef struct {
+	const char *name;
+	configType_t type;
+	int32_t def;
+	int32_t min;
+	int32_t max;
+} configSchema_t;
+
+/** Public function prototypes ---------------------------------------------- */
+void config_Mount(void);
+const configSchema_t *config_Schema(uint8_t key);
+int32_t config_Get(uint8_t key);
+uint8_t config_Set(uint8_t key, int32_t value);
+uint8_t config_Pending(void);
+uint8_t config_FlushStep(void);
+uint8_t config_Flush(void);
+void config_Print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __CONFIG_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file		crc16.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Table driven CRC-16 for the records kept in the EEPROM.
+ *
+ * The table is built by the compiler from the macros below, there is
+ * nothing to generate or to initialize at run time. CRC is linear, so the
+ * entry for a byte is the XOR of the entries for its single bits and only
+ * those eight are shifted through the polynomial.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include "crc16.h"
+#include "systemTicks.h"
+#include "debugUsart.h"
+
+/** Private defines --------------------------------------------------------- */
+#define CRC16_STEP(c)		((((c) << 1) ^ (((c) >> 15) & 1) * CRC16_POLY) \
+								& 0xFFFF)
+#define CRC16_STEP4(c)		CRC16_STEP(CRC16_STEP(CRC16_STEP(CRC16_STEP(c))))
+#define CRC16_BIT(b)		CRC16_STEP4(CRC16_STEP4((1 << (b)) << 8))
+
+#define CRC16_ENTRY(i) \
+	(uint16_t) ((((i) & 0x01) ? CRC16_BIT(0) : 0) \
+			^ (((i) & 0x02) ? CRC16_BIT(1) : 0) \
+			^ (((i) & 0x04) ? CRC16_BIT(2) : 0) \
+			^ (((i) & 0x08) ? CRC16_BIT(3) : 0) \
+			^ (((i) & 0x10) ? CRC16_BIT(4) : 0) \
+			^ (((i) & 0x20) ? CRC16_BIT(5) : 0) \
+			^ (((i) & 0x40) ? CRC16_BIT(6) : 0) \
+			^ (((i) & 0x80) ? CRC16_BIT(7) : 0))
+
+#define CRC16_4(i)			CRC16_ENTRY(i), CRC16_ENTRY((i) + 1), \
+							CRC16_ENTRY((i) + 2), CRC16_ENTRY((i) + 3)
+#define CRC16_16(i)			CRC16_4(i), CRC16_4((i) + 4), \
+							CRC16_4((i) + 8), CRC16_4((i) + 12)
+#define CRC16_64(i)			CRC16_16(i), CRC16_16((i) + 16), \
+							CRC16_16((i) + 32), CRC16_16((i) + 48)
+
+/** Private variables ------------------------------------------------------- */
+static const uint16_t Crc16Table[256] = { CRC16_64(0), CRC16_64(64),
+		CRC16_64(128), CRC16_64(192) };
+
+/** Private functions ------------------------------------------------------- */
+// Same CRC one bit at a time, only for the benchmark
+static uint16_t crc16_Bitwise(const uint8_t *data, uint16_t len) {
+	uint16_t crc = CRC16_INIT;
+	uint8_t i;
+
+	while (len--) {
+		crc ^= (uint16_t) *data++ << 8;
+		for (i = 0; i < 8; i++) {
+			crc = CRC16_STEP(crc);
+		}
+	}
+	return crc;
+}
+
+// Checksum the EEPROM image had before
+static uint8_t crc16_Xor(const uint8_t *data, uint16_t len) {
+	uint8_t sum = 0;
+
+	while (len--) {
+		sum ^= *data++;
+	}
+	return sum;
+}
+
+/** Public functions -------------------------------------------------------- */
+uint16_t crc16_Update(uint16_t crc, const uint8_t *data, uint16_t len) {
+	while (len--) {
+		crc = (crc << 8) ^ Crc16Table[(crc >> 8) ^ *data++];
+	}
+	return crc;
+}
+
+uint16_t crc16(const uint8_t *data, uint16_t len) {
+	return crc16_Update(CRC16_INIT, data, len);
+}
+
+// Print the cost in CPU cycles of a history record and a 128 byte block
+void crc16_Benchmark(void) {
+	static const uint16_t Sizes[] = { 16, 128 };
+	uint8_t data[128];
+	uint32_t start, xor, table, bitwise;
+	volatile uint16_t result;
+	uint8_t i;
+
+	InitCycleCounter();
+	for (i = 0; i < sizeof(data); i++) {
+		data[i] = i * 37;
+	}
+
+	for (i = 0; i < sizeof(Sizes) / sizeof(Sizes[0]); i++) {
+		start = CYCLES();
+		result = crc16_Xor(data, Sizes[i]);
+		xor = CYCLES() - start;
+		start = CYCLES();
+		result = crc16(data, Sizes[i]);
+		table = CYCLES() - start;
+		start = CYCLES();
+		result = crc16_Bitwise(data, Sizes[i]);
+		bitwise = CYCLES() - start;
+		debug.printf("%3u bytes: XOR %5u, CRC-16 table %5u, bitwise %5u cycles\r\n",
+				Sizes[i], xor, table, bitwise);
+	}
+	(void) result;
+}
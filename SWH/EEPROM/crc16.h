@@ -0,0 +1,36 @@
+/**
+ ******************************************************************************
+ * @file		crc16.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __CRC16_H
+#define __CRC16_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "stm32f10x.h"
+
+/** Defines ----------------------------------------------------------------- */
+// CRC-16/CCITT-FALSE
+#define CRC16_POLY					0x1021
+#define CRC16_INIT					0xFFFF
+
+/** Public function prototypes ---------------------------------------------- */
+uint16_t crc16(const uint8_t *data, uint16_t len);
+uint16_t crc16_Update(uint16_t crc, const uint8_t *data, uint16_t len);
+void crc16_Benchmark(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __CRC16_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -11,100 +11,159 @@
  ******************************************************************************
  */
 
+#include <stddef.h>
 #include <string.h>
 #include "eeprom.h"
-#include "at24c32.h"
+#include "blockdev.h"
+#include "crc16.h"
 #include "defines.h"
 #include "debugUsart.h"
 
 //variables
 EEPROM_Array_t m_EEPROM_Array;
 
+static const uint16_t m_slotAddress[EEPROM_SLOTS] = { EEPROM_SLOT_A,
+		EEPROM_SLOT_B };
+
+static uint16_t at24c_crc(const EEPROM_Array_t *image) {
+	return crc16((const uint8_t *) image, offsetof(EEPROM_Array_t, _CRC));
+}
+
+// Copy is good if the header and the CRC match, a torn write fails the CRC
+static uint8_t at24c_valid(const EEPROM_Array_t *image) {
+	return (image->Header == EEPROM_HEADER)
+			&& (image->_CRC == at24c_crc(image));
+}
+
+// Configuration image written before config.c, config_Mount moves it over
 uint8_t at24c_read(void) {
-	uint16_t tmpIndex;
-	uint16_t tmpAddress = 0x00;
-	unsigned char tmpCRC, tmpHeader;
+	uint8_t tmpImage[EEPROM_SLOT_B + EEPROM_IMAGE_SIZE];
+	EEPROM_Array_t tmpCopy[EEPROM_SLOTS];
+	uint8_t tmpValid[EEPROM_SLOTS];
+	uint8_t tmpSlot;
 
 	memset(m_EEPROM_Array.Payload.Byte, 0x00, MAX_NUMBER_OF_PAYLOAD_BYTES);
 
+	// both copies in one sequential read
 //	debug.printf("EEPROMGet: Reading Data...\r\n");
-	if (!at24c_readByte(tmpAddress, &m_EEPROM_Array.Header)) { //read header byte
+	if (!blockdev_Read(EEPROM_SLOT_A, tmpImage, sizeof(tmpImage))) {
 		DebugChangeColorToRED();
 		debug.printf("EEPROMGet: Error I2C\r\n");
 		DebugChangeColorToGREEN();
 		return false;
 	}
-//	debug.printf("Header:%02X\r\n", m_EEPROM_Array.Header);
-	tmpCRC = m_EEPROM_Array.Header;
-	tmpAddress++;
-	tmpIndex = 0;
-	while (tmpIndex < MAX_NUMBER_OF_PAYLOAD_BYTES) {
-		at24c_readByte(tmpAddress, &m_EEPROM_Array.Payload.Byte[tmpIndex]); //read 1 byte
-		tmpCRC ^= m_EEPROM_Array.Payload.Byte[tmpIndex];
-//		debug.printf("%02d:%02X\r\n", tmpIndex,
-//				m_EEPROM_Array.Payload.Byte[tmpIndex]);
-		tmpIndex++;
-		tmpAddress++;
-	}
-	//read crc
-	at24c_readByte(tmpAddress, &m_EEPROM_Array._CRC); //read 1 byte
-//	debug.printf("CRC:   %d\r\n", m_EEPROM_Array._CRC);
 
-	tmpCRC = tmpCRC ^ m_EEPROM_Array._CRC;
+	for (tmpSlot = 0; tmpSlot < EEPROM_SLOTS; tmpSlot++) {
+		memcpy(&tmpCopy[tmpSlot], &tmpImage[m_slotAddress[tmpSlot]],
+				EEPROM_IMAGE_SIZE);
+		tmpValid[tmpSlot] = at24c_valid(&tmpCopy[tmpSlot]);
+	}
 
-	tmpHeader = m_EEPROM_Array.Header;
-	if ((0x5A == tmpHeader) && (tmpCRC == 0)) {
-		debug.printf("EEPROMGet: Format OK\r\n");
-		return true;
-	} else {
+	if (!tmpValid[0] && !tmpValid[1]) {
 		DebugChangeColorToRED();
 		debug.printf("EEPROMGet: Bad format\r\n");
 		DebugChangeColorToGREEN();
 		return false;
 	}
+
+	// newest valid copy, sequence wraps so compare the difference
+	if (tmpValid[0] && tmpValid[1]) {
+		tmpSlot = (int8_t) (tmpCopy[1].Sequence - tmpCopy[0].Sequence) > 0;
+	} else {
+		tmpSlot = tmpValid[1];
+		DebugChangeColorToRED();
+		debug.printf("EEPROMGet: Copy %c bad\r\n", tmpSlot ? 'A' : 'B');
+		DebugChangeColorToGREEN();
+	}
+
+	m_EEPROM_Array = tmpCopy[tmpSlot];
+	debug.printf("EEPROMGet: Format OK\r\n");
+	return true;
 }
 
-uint8_t at24c_write(void) {
-	uint16_t tmpIndex;
-	uint16_t tmpAddress = 0x00;
+// Record of the first image, false if the slot was never written
+static uint8_t at24c_legacyRecord(const uint8_t *record, historyData_t *data) {
+	TimeStruct_t time;
 
-	m_EEPROM_Array.Header = 0x5A;
-	m_EEPROM_Array._CRC = 0x5A;
+	time.year = record[0];
+	time.month = record[1];
+	time.date = record[2];
+	time.hours_24 = record[3];
+	time.minutes = record[4];
+	time.seconds = record[5];
+	if (time.year > 99 || time.month < 1 || time.month > 12 || time.date < 1
+			|| time.date > 31 || time.hours_24 > 23 || time.minutes > 59
+			|| time.seconds > 59) {
+		return false;
+	}
 
-//	debug.printf("EEPROMPut: Writing Data..\r\n");
-	if (!at24c_writeAcrossPages(tmpAddress, &m_EEPROM_Array.Header, 1, true)) { //write header byte
-		DebugChangeColorToRED();
-		debug.printf("EEPROMPut: Error I2C\r\n");
-		DebugChangeColorToGREEN();
+	memset(data, 0, sizeof(historyData_t));
+	data->timestamp = clock_FromTime(&time);
+	data->status.B = record[6];
+	data->tempBoiler = (int16_t) (record[8] | record[9] << 8);
+	data->tempWaterHeater = (int16_t) (record[10] | record[11] << 8);
+	data->tempCollector = (int16_t) (record[12] | record[13] << 8);
+	return true;
+}
+
+// Image of the first firmware, header 0x5A and an XOR checksum, records
+// are put in order of time
+uint8_t at24c_readLegacy(EEPROM_Legacy_t *legacy) {
+	uint8_t tmpImage[EEPROM_LEGACY_SIZE];
+	uint8_t tmpXor = 0;
+	uint8_t tmpIndex, tmpSlot;
+	historyData_t tmpData;
+
+	if (!blockdev_Read(0, tmpImage, sizeof(tmpImage))) {
 		return false;
 	}
-//	debug.printf("Header:%02X\r\n", m_EEPROM_Array.Header);
-	tmpAddress++;
-
-	// Calc CRC
-	tmpIndex = 0x00;
-	while (tmpIndex < MAX_NUMBER_OF_PAYLOAD_BYTES) {
-		m_EEPROM_Array._CRC ^= m_EEPROM_Array.Payload.Byte[tmpIndex];
-//		debug.printf("%02d:%02X\r\n", tmpIndex,
-//				m_EEPROM_Array.Payload.Byte[tmpIndex]);
-		tmpIndex++;
+	for (tmpIndex = 0; tmpIndex < EEPROM_LEGACY_SIZE; tmpIndex++) {
+		tmpXor ^= tmpImage[tmpIndex];
+	}
+	if (tmpImage[0] != EEPROM_LEGACY_HEADER || tmpXor != 0) {
+		return false;
 	}
 
-	at24c_writeAcrossPages(tmpAddress, m_EEPROM_Array.Payload.Byte,
-			MAX_NUMBER_OF_PAYLOAD_BYTES, true);
-	tmpAddress += MAX_NUMBER_OF_PAYLOAD_BYTES;
-
-	at24c_writeAcrossPages(tmpAddress, &m_EEPROM_Array._CRC, 1, true); //write CRC byte
-//	debug.printf("CRC:   %d\r\n", m_EEPROM_Array._CRC);
+	legacy->count = 0;
+	legacy->deltaPlus = tmpImage[EEPROM_LEGACY_INDEX + 1];
+	legacy->deltaMinus = tmpImage[EEPROM_LEGACY_INDEX + 2];
+	for (tmpIndex = 0; tmpIndex < EEPROM_LEGACY_HISTORIES; tmpIndex++) {
+		if (!at24c_legacyRecord(
+				&tmpImage[1 + tmpIndex * EEPROM_LEGACY_RECORD_SIZE],
+				&tmpData)) {
+			continue;
+		}
+		// insertion sort, ten records at most
+		for (tmpSlot = legacy->count; tmpSlot > 0
+				&& legacy->data[tmpSlot - 1].timestamp > tmpData.timestamp;
+				tmpSlot--) {
+			legacy->data[tmpSlot] = legacy->data[tmpSlot - 1];
+		}
+		legacy->data[tmpSlot] = tmpData;
+		legacy->count++;
+	}
+	debug.printf("EEPROMGet: First format, %d records\r\n", legacy->count);
 	return true;
 }
 
-void at24c_test(void) {
-	uint16_t tmpIndex;
-	for (tmpIndex = 0; tmpIndex < MAX_NUMBER_OF_PAYLOAD_BYTES; tmpIndex++) {
-		m_EEPROM_Array.Payload.Byte[tmpIndex] = tmpIndex;
+// Print the whole EEPROM in hex, host/eeprom_tool reads it back
+void eeprom_Dump(void) {
+	uint8_t tmpLine[EEPROM_DUMP_LINE];
+	uint32_t tmpAddress;
+	uint8_t tmpIndex;
+
+	for (tmpAddress = 0; tmpAddress < blockdev_Size();
+			tmpAddress += EEPROM_DUMP_LINE) {
+		if (!blockdev_Read(tmpAddress, tmpLine, EEPROM_DUMP_LINE)) {
+			DebugChangeColorToRED();
+			debug.printf("EEPROMDump: Error I2C\r\n");
+			DebugChangeColorToGREEN();
+			return;
+		}
+		debug.printf("%04X:", (unsigned int) tmpAddress);
+		for (tmpIndex = 0; tmpIndex < EEPROM_DUMP_LINE; tmpIndex++) {
+			debug.printf(" %02X", tmpLine[tmpIndex]);
+		}
+		debug.printf("\r\n");
 	}
-	at24c_write();
-	at24c_read();
 }
-
@@ -15,10 +15,37 @@
 #define	EEPROM_H
 
 #include "stm32f10x.h"
-#include "ds1307_mid_level.h"
+#include "clock.h"
 
-#define MAX_NUMBER_OF_HISTORIES			10
-#define MAX_NUMBER_OF_PAYLOAD_BYTES		(const int)(MAX_NUMBER_OF_HISTORIES * 14 + 3)
+// Configuration image written before the entries of config.c, only read
+// to move the deltas over. Header was changed whenever the layout below
+// changed, an old image reads as bad format. Headers 0x5B to 0x5D were
+// never released and have no reader, a unit upgraded from the first
+// firmware has the 0x5A image below and that one is moved over in one step.
+#define EEPROM_HEADER					0x5E
+
+#define MAX_NUMBER_OF_PAYLOAD_BYTES		(const int)(2)
+// Header, sequence, payload and CRC as they are in the EEPROM
+#define EEPROM_IMAGE_SIZE				sizeof(EEPROM_Array_t)
+
+// Two copies in different pages, a write goes to the older one so a write
+// cut short by a reset leaves the other one valid
+#define EEPROM_SLOT_A					0x0000
+#define EEPROM_SLOT_B					0x0020
+#define EEPROM_SLOTS					2
+
+// Bytes in a line of eeprom_Dump
+#define EEPROM_DUMP_LINE				0x20
+
+// Image of the first firmware at address 0: header, ten history records
+// in a ring, the index of the newest one, the deltas and an XOR of all
+// the bytes before it. Only read, config_Migrate moves it over.
+#define EEPROM_LEGACY_HEADER			0x5A
+#define EEPROM_LEGACY_HISTORIES			10
+#define EEPROM_LEGACY_RECORD_SIZE		14	// time, status, reserved, temps
+#define EEPROM_LEGACY_INDEX				(1 + EEPROM_LEGACY_HISTORIES \
+											* EEPROM_LEGACY_RECORD_SIZE)
+#define EEPROM_LEGACY_SIZE				(EEPROM_LEGACY_INDEX + 4)
 
 typedef union {
 	struct {
@@ -31,7 +58,7 @@ typedef union {
 } StatusByte_t;
 
 typedef struct {
-	TimeStruct_t time;
+	uint32_t timestamp;		// seconds since CLOCK_EPOCH_YEAR
 	StatusByte_t status;
 	uint8_t reserved;
 
@@ -42,9 +69,6 @@ typedef struct {
 
 typedef union {
 	struct {
-		historyData_t data[MAX_NUMBER_OF_HISTORIES];
-		uint8_t currentIndex;
-
 		uint8_t deltaPlus;
 		uint8_t deltaMinus;
 	} Item;
@@ -53,15 +77,23 @@ typedef union {
 
 typedef struct {
 	unsigned char Header;
+	unsigned char Sequence;		// newer copy has the higher one, wraps
 	Payload_t Payload;
-	unsigned char _CRC;
+	uint16_t _CRC;				// CRC-16 of everything above
 } EEPROM_Array_t;
 
+typedef struct {
+	historyData_t data[EEPROM_LEGACY_HISTORIES];	// oldest first
+	uint8_t count;
+	uint8_t deltaPlus;
+	uint8_t deltaMinus;
+} EEPROM_Legacy_t;
+
 extern EEPROM_Array_t m_EEPROM_Array;
 
 uint8_t at24c_read(void);
-uint8_t at24c_write(void);
-void at24c_test(void);
+uint8_t at24c_readLegacy(EEPROM_Legacy_t *legacy);
+void eeprom_Dump(void);
 
 #endif	/* EEPROM_H */
 
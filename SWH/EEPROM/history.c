@@ -0,0 +1,300 @@
+/**
+ ******************************************************************************
+ * @file		history.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		History of pump events as a log over the EEPROM.
+ *
+ * The EEPROM from HISTORY_START to HISTORY_END is split in blocks written
+ * one after the other and then from the start again, so every block is
+ * written equally often. A block starts with a key record that holds the
+ * sequence number of its first record, the records after it are the delta
+ * records from record.c, each one written with one page write as it comes.
+ * A record going into a page the first time clears the rest of the page,
+ * so what is left from the lap before reads as the end of the records.
+ *
+ * Block 0 and the blocks after it up to the newest one have key sequence
+ * numbers counting up from the one in block 0, the blocks after the newest
+ * one are empty, torn or from the lap before. That makes the newest block
+ * easy to find with a binary search at mount, a few reads instead of
+ * reading the whole log. A record is found the same way, by the sequence
+ * numbers of the key records, and decoded from the key record of its block.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "history.h"
+#include "record.h"
+#include "defines.h"
+#include "debugUsart.h"
+
+/** Private defines --------------------------------------------------------- */
+#define HISTORY_NO_BLOCK			0xFFFF
+
+/** Private variables ------------------------------------------------------- */
+static uint16_t m_historyHead;		// block of the newest record
+static uint16_t m_historyKey;		// sequence of the key record in the head
+static uint8_t m_historyOffset;		// where the next record goes in the head
+									// block, 0 if the log is empty
+static historyData_t m_historyLast;	// newest record, next delta is from it
+static uint16_t m_historyOldest;	// block of the oldest record
+static uint16_t m_historyFirst;		// sequence number of the oldest record
+static uint16_t m_historySequence;	// sequence number of the next record
+
+// Last block read, records are decoded from here
+static uint8_t m_historyCache[HISTORY_BLOCK_SIZE];
+static uint16_t m_historyCacheBlock = HISTORY_NO_BLOCK;
+
+/** Private functions ------------------------------------------------------- */
+static uint32_t history_Address(uint16_t block) {
+	return HISTORY_START + (uint32_t) block * HISTORY_BLOCK_SIZE;
+}
+
+// Key record of the block, false if it's empty or torn
+static uint8_t history_ReadKey(uint16_t block, uint16_t *sequence,
+		historyData_t *data) {
+	uint8_t key[RECORD_KEY_SIZE];
+
+	if (!blockdev_Read(history_Address(block), key, sizeof(key))) {
+		return false;
+	}
+	return record_DecodeKey(key, sequence, data) != 0;
+}
+
+static uint8_t history_ReadBlock(uint16_t block) {
+	if (m_historyCacheBlock == block) {
+		return true;
+	}
+	m_historyCacheBlock = HISTORY_NO_BLOCK;
+	if (!blockdev_Read(history_Address(block), m_historyCache,
+			HISTORY_BLOCK_SIZE)) {
+		return false;
+	}
+	m_historyCacheBlock = block;
+	return true;
+}
+
+// Decode the cached block up to count records after the key record, count
+// is set to the records decoded and data to the last one, returns the
+// offset after it, 0 if the key record isn't valid
+static uint8_t history_Walk(uint16_t *key, historyData_t *data,
+		uint8_t *count) {
+	uint8_t offset, len, limit = *count;
+
+	if (!record_DecodeKey(m_historyCache, key, data)) {
+		return 0;
+	}
+	offset = RECORD_KEY_SIZE;
+	for (*count = 0; *count < limit; (*count)++) {
+		len = record_Decode(*key, data, &m_historyCache[offset],
+				HISTORY_BLOCK_SIZE - offset, data);
+		if (len == 0) {
+			break;
+		}
+		offset += len;
+	}
+	return offset;
+}
+
+// Bytes to write for a record of len at addr, a record going into a page
+// the first time is followed by 0xFF up to the end of the page, the block
+// if the page is bigger
+static uint8_t history_Fill(uint32_t addr, uint8_t len, uint8_t *buffer) {
+	uint32_t page = blockdev_Geometry()->pageSize;
+	uint32_t end = addr + len;
+	uint32_t blockEnd = addr - (addr - HISTORY_START) % HISTORY_BLOCK_SIZE
+			+ HISTORY_BLOCK_SIZE;
+
+	if (page > HISTORY_BLOCK_SIZE) {
+		page = HISTORY_BLOCK_SIZE;
+	}
+
+	if (addr % page != 0 && addr / page == (end - 1) / page) {
+		return len;
+	}
+	end = ((end - 1) / page + 1) * page;
+	if (end > blockEnd) {
+		end = blockEnd;
+	}
+	memset(&buffer[len], 0xFF, end - addr - len);
+	return end - addr;
+}
+
+/** Public functions -------------------------------------------------------- */
+// Find the newest record, called once at boot
+void history_Mount(void) {
+	historyData_t data;
+	uint16_t first, sequence, low, high, middle, block;
+	uint8_t count, i;
+
+	m_historyHead = HISTORY_BLOCKS - 1;
+	m_historyOffset = 0;
+	m_historyOldest = 0;
+	m_historyFirst = 0;
+	m_historySequence = 0;
+	m_historyCacheBlock = HISTORY_NO_BLOCK;
+
+	if (!history_ReadKey(0, &first, &data)) {
+		// Torn key record in block 0 after the log wrapped, newest is the
+		// last block
+		low = HISTORY_BLOCKS - 1;
+	} else {
+		// Last block in the same lap as block 0
+		low = 0;
+		high = HISTORY_BLOCKS - 1;
+		while (low < high) {
+			middle = (low + high + 1) / 2;
+			if (history_ReadKey(middle, &sequence, &data)
+					&& (int16_t) (sequence - first) > 0) {
+				low = middle;
+			} else {
+				high = middle - 1;
+			}
+		}
+	}
+
+	count = HISTORY_BLOCK_SIZE;
+	if (!history_ReadBlock(low)) {
+		return;
+	}
+	m_historyOffset = history_Walk(&m_historyKey, &m_historyLast, &count);
+	if (m_historyOffset == 0) {
+		debug.printf("History: empty\r\n");
+		return;
+	}
+	m_historyHead = low;
+	m_historySequence = m_historyKey + 1 + count;
+
+	// Oldest block is the one after the head if it's from the lap before,
+	// the one after that if it is torn, block 0 if the log didn't wrap yet
+	for (i = 1; i <= 2; i++) {
+		block = (low + i) % HISTORY_BLOCKS;
+		if (block != low && history_ReadKey(block, &sequence, &data)
+				&& (int16_t) (sequence - m_historyKey) < 0) {
+			m_historyOldest = block;
+			break;
+		}
+	}
+	if (!history_ReadKey(m_historyOldest, &m_historyFirst, &data)) {
+		m_historyOldest = m_historyHead;
+		m_historyFirst = m_historyKey;
+	}
+
+	debug.printf("History: %d records, next %d\r\n", history_Count(),
+			m_historySequence);
+}
+
+uint8_t history_Append(const historyData_t *data) {
+	uint8_t buffer[HISTORY_BLOCK_SIZE];
+	uint16_t block = m_historyHead, key = m_historyKey;
+	uint16_t oldestBlock = m_historyOldest, first = m_historyFirst;
+	uint8_t offset = m_historyOffset, len = 0;
+	historyData_t oldest;
+
+	if (offset != 0) {
+		len = record_Encode(key, &m_historyLast, data, buffer);
+	}
+	if (len == 0 || offset + len > HISTORY_BLOCK_SIZE) {
+		// Next block, starting with a key record
+		block = (block + 1) % HISTORY_BLOCKS;
+		key = m_historySequence;
+		offset = 0;
+		len = record_EncodeKey(key, data, buffer);
+	}
+
+	if (m_historyOffset == 0) {
+		// First record of the log
+		oldestBlock = block;
+		first = key;
+	} else if (block != m_historyHead && block == m_historyOldest) {
+		// Oldest block overwritten, the next one is the oldest now. Read
+		// before the write, its pages after the first go in the background.
+		oldestBlock = (block + 1) % HISTORY_BLOCKS;
+		if (!history_ReadKey(oldestBlock, &first, &oldest)) {
+			oldestBlock = block;
+			first = key;
+		}
+	}
+
+	if (!blockdev_Write(history_Address(block) + offset, buffer,
+			history_Fill(history_Address(block) + offset, len, buffer),
+			false)) {
+		return false;
+	}
+	m_historyCacheBlock = HISTORY_NO_BLOCK;
+
+	m_historyOldest = oldestBlock;
+	m_historyFirst = first;
+	m_historyHead = block;
+	m_historyKey = key;
+	m_historyOffset = offset + len;
+	m_historyLast = *data;
+	m_historyLast.status.B &= RECORD_STATUS_MASK;
+	m_historyLast.reserved = 0;
+	m_historySequence++;
+	return true;
+}
+
+// Record written age records ago, 0 is the newest, false if it isn't valid
+uint8_t history_Get(uint16_t age, historyData_t *data) {
+	uint16_t target, key, low, high, middle, blocks;
+	uint8_t count;
+
+	if (age >= history_Count()) {
+		return false;
+	}
+	target = m_historySequence - 1 - age;
+
+	// Records next to each other are mostly in the block read last
+	if (m_historyCacheBlock != HISTORY_NO_BLOCK
+			&& record_DecodeKey(m_historyCache, &key, data)
+			&& (int16_t) (target - key) >= 0
+			&& (int16_t) (target - key) < HISTORY_BLOCK_SIZE) {
+		count = target - key;
+		if (history_Walk(&key, data, &count) != 0 && count == target - key) {
+			return true;
+		}
+	}
+
+	// Last block, counted from the oldest, with the key record not after it
+	blocks = (m_historyHead + HISTORY_BLOCKS - m_historyOldest)
+			% HISTORY_BLOCKS;
+	low = 0;
+	high = blocks;
+	while (low < high) {
+		middle = (low + high + 1) / 2;
+		if (!history_ReadKey((m_historyOldest + middle) % HISTORY_BLOCKS, &key,
+				data)) {
+			return false;
+		}
+		if ((int16_t) (target - key) >= 0) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	if (!history_ReadBlock((m_historyOldest + low) % HISTORY_BLOCKS)) {
+		return false;
+	}
+	if (!record_DecodeKey(m_historyCache, &key, data)) {
+		return false;
+	}
+	count = target - key;
+	if (history_Walk(&key, data, &count) == 0 || count != target - key) {
+		return false;
+	}
+	return true;
+}
+
+uint16_t history_Count(void) {
+	if (m_historyOffset == 0) {
+		return 0;
+	}
+	return m_historySequence - m_historyFirst;
+}
+
+uint16_t history_NextSequence(void) {
+	return m_historySequence;
+}
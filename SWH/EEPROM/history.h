@@ -0,0 +1,46 @@
+/**
+ ******************************************************************************
+ * @file		history.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __HISTORY_H
+#define __HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "eeprom.h"
+#include "blockdev.h"
+#include "rollup.h"
+#include "config.h"
+
+/** Defines ----------------------------------------------------------------- */
+// EEPROM after the configuration, up to the rollups
+#define HISTORY_START				CONFIG_END
+#define HISTORY_END					ROLLUP_START
+
+// Records are kept in blocks, each starts with a key record
+#define HISTORY_BLOCK_SIZE			0x80
+#define HISTORY_BLOCKS				((uint16_t) ((HISTORY_END - HISTORY_START) \
+										/ HISTORY_BLOCK_SIZE))
+
+/** Public function prototypes ---------------------------------------------- */
+void history_Mount(void);
+uint8_t history_Append(const historyData_t *data);
+uint8_t history_Get(uint16_t age, historyData_t *data);
+uint16_t history_Count(void);
+uint16_t history_NextSequence(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __HISTORY_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -0,0 +1,247 @@
+/**
+ ******************************************************************************
+ * @file		journal.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Write-behind journal of history and deltas.
+ *
+ * History records and delta changes are queued in RAM and return at once,
+ * the EEPROM is written by journal_Task in the background. It waits until
+ * nothing changed for JOURNAL_QUIET_PERIOD, or JOURNAL_DEADLINE after the
+ * first change, so a run of delta changes ends up as one write. Every run
+ * of the task does at most one page write and only when the EEPROM is done
+ * with the one before, the control loop never waits for a write cycle.
+ *
+ * When the DS1307 is there the queue is also kept in its battery backed
+ * RAM, which takes one I2C transaction and has no write cycle, and at boot
+ * whatever was in it when the power went off ends up in the EEPROM. A
+ * record is written first and the record count after it, so a record is
+ * either in the journal or not. The journal holds the history sequence
+ * number of its first record, records the history already has are skipped
+ * after a power loss. When the queue is full the oldest record not written
+ * is dropped, nothing is written around the queue.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "journal.h"
+#include "defines.h"
+#include "systemTicks.h"
+#include "debugUsart.h"
+
+/** Private variables ------------------------------------------------------- */
+static uint8_t m_nvramReady;		// DS1307 answered at boot
+static uint8_t m_journalCount;		// records in the journal
+static uint8_t m_journalFlushed;	// records at the start in the history now
+static uint32_t m_firstChange;		// micros of the oldest change not written
+static uint32_t m_lastChange;		// micros of the newest change
+// Copy of the records in the journal
+static historyData_t m_journalRecords[JOURNAL_MAX_RECORDS];
+
+/** Private functions ------------------------------------------------------- */
+// Empty journal, next record is the next one of the history
+static void journal_Reset(void) {
+	uint8_t header[JOURNAL_RECORDS_OFFSET];
+	uint16_t sequence = history_NextSequence();
+
+	header[JOURNAL_MAGIC_OFFSET] = JOURNAL_MAGIC;
+	header[JOURNAL_SEQUENCE_OFFSET] = sequence & 0xFF;
+	header[JOURNAL_SEQUENCE_OFFSET + 1] = sequence >> 8;
+	header[JOURNAL_DELTA_OFFSET] = config_Get(CONFIG_DELTA_PLUS);
+	header[JOURNAL_DELTA_OFFSET + 1] = config_Get(CONFIG_DELTA_MINUS);
+	header[JOURNAL_COUNT_OFFSET] = 0;
+	if (m_nvramReady) {
+		ds1307_write_ram(0, header, sizeof(header));
+	}
+
+	m_journalCount = 0;
+	m_journalFlushed = 0;
+}
+
+// Add a record to the journal, written record count commits it
+static void journal_WriteRecord(const historyData_t *data) {
+	m_journalRecords[m_journalCount] = *data;
+	m_journalCount++;
+	if (m_nvramReady) {
+		ds1307_write_ram(
+				JOURNAL_RECORDS_OFFSET
+						+ (m_journalCount - 1) * sizeof(historyData_t),
+				(uint8_t *) data, sizeof(historyData_t));
+		ds1307_write_ram(JOURNAL_COUNT_OFFSET, &m_journalCount, 1);
+	}
+}
+
+// Start over with the records from first on, the ones before are in the
+// history now
+static void journal_Restart(uint8_t first) {
+	historyData_t pending[JOURNAL_MAX_RECORDS];
+	uint8_t i, count = m_journalCount - first;
+
+	memcpy(pending, &m_journalRecords[first], count * sizeof(historyData_t));
+	journal_Reset();
+	for (i = 0; i < count; i++) {
+		journal_WriteRecord(&pending[i]);
+	}
+}
+
+static uint8_t journal_Pending(void) {
+	return m_journalFlushed < m_journalCount || config_Pending();
+}
+
+// Start the quiet period again, and the deadline with the first change
+static void journal_Changed(void) {
+	if (!journal_Pending()) {
+		m_firstChange = micros;
+	}
+	m_lastChange = micros;
+}
+
+// Write the oldest pending change to the EEPROM, false if it didn't go
+static uint8_t journal_FlushStep(void) {
+	if (m_journalFlushed < m_journalCount) {
+		if (!history_Append(&m_journalRecords[m_journalFlushed])) {
+			return false;
+		}
+		m_journalFlushed++;
+	} else if (!config_FlushStep()) {
+		return false;
+	}
+
+	// Everything is in the EEPROM, journal starts over once the last write
+	// is done, else journal_Task does it
+	if (!journal_Pending() && blockdev_IsReady()) {
+		journal_Restart(m_journalFlushed);
+	}
+	return true;
+}
+
+/** Public functions -------------------------------------------------------- */
+// Bring the EEPROM up to date with the journal, called once at boot after
+// the configuration is read and the history is mounted
+void journal_Replay(void) {
+	uint8_t header[JOURNAL_RECORDS_OFFSET];
+	uint16_t skip;
+	uint8_t i;
+
+	m_nvramReady = ds1307_is_present();
+	if (!m_nvramReady) {
+		journal_Reset();
+		return;
+	}
+
+	ds1307_read_ram(0, header, sizeof(header));
+	if (header[JOURNAL_MAGIC_OFFSET] != JOURNAL_MAGIC
+			|| header[JOURNAL_COUNT_OFFSET] > JOURNAL_MAX_RECORDS) {
+		journal_Reset();
+		return;
+	}
+
+	// config_Set takes the deltas only if they are in range
+	if (header[JOURNAL_DELTA_OFFSET + 1] < header[JOURNAL_DELTA_OFFSET]) {
+		config_Set(CONFIG_DELTA_PLUS, header[JOURNAL_DELTA_OFFSET]);
+		config_Set(CONFIG_DELTA_MINUS, header[JOURNAL_DELTA_OFFSET + 1]);
+	}
+
+	// Records before the next sequence of the history are in it already
+	skip = history_NextSequence()
+			- (header[JOURNAL_SEQUENCE_OFFSET]
+					| header[JOURNAL_SEQUENCE_OFFSET + 1] << 8);
+	if (skip > header[JOURNAL_COUNT_OFFSET]) {
+		skip = header[JOURNAL_COUNT_OFFSET];
+	}
+	m_journalCount = 0;
+	for (i = skip; i < header[JOURNAL_COUNT_OFFSET]; i++) {
+		ds1307_read_ram(JOURNAL_RECORDS_OFFSET + i * sizeof(historyData_t),
+				(uint8_t *) &m_journalRecords[m_journalCount],
+				sizeof(historyData_t));
+		m_journalCount++;
+	}
+	debug.printf("Journal: %d records replayed\r\n", m_journalCount);
+
+	// Journal has to start at the next sequence of the history again
+	if (skip > 0) {
+		journal_Restart(0);
+	}
+	if (m_journalCount == 0 && !config_Pending()) {
+		journal_Reset();
+	} else {
+		journal_Compact();
+	}
+}
+
+void journal_AddHistory(const historyData_t *data) {
+	// Full, the EEPROM is not taking records. The ones in the history make
+	// room first, else the oldest record not written is dropped so the
+	// newest ones are kept. Only the DS1307 is written here, the EEPROM is
+	// left to journal_Task.
+	if (m_journalCount >= JOURNAL_MAX_RECORDS) {
+		if (m_journalFlushed > 0) {
+			journal_Restart(m_journalFlushed);
+		} else {
+			journal_Restart(1);
+			debug.printf("Journal: full, oldest record dropped\r\n");
+		}
+	}
+
+	journal_Changed();
+	journal_WriteRecord(data);
+}
+
+void journal_SetDelta(uint8_t deltaPlus, uint8_t deltaMinus) {
+	uint8_t delta[2] = { deltaPlus, deltaMinus };
+
+	journal_Changed();
+	config_Set(CONFIG_DELTA_PLUS, deltaPlus);
+	config_Set(CONFIG_DELTA_MINUS, deltaMinus);
+	if (m_nvramReady) {
+		ds1307_write_ram(JOURNAL_DELTA_OFFSET, delta, sizeof(delta));
+	}
+}
+
+// Write pending changes one at a time once they are due, task
+void journal_Task(void) {
+	if (!journal_Pending()) {
+		// Records written in the background are in the EEPROM now
+		if (m_journalFlushed > 0 && blockdev_IsReady()) {
+			journal_Restart(m_journalFlushed);
+		}
+		return;
+	}
+	if (!TIMEOUT(m_lastChange, JOURNAL_QUIET_PERIOD)
+			&& !TIMEOUT(m_firstChange, JOURNAL_DEADLINE)
+			&& m_journalCount < JOURNAL_MAX_RECORDS) {
+		return;
+	}
+	if (!blockdev_IsReady()) {
+		return;
+	}
+
+	if (!journal_FlushStep()) {
+		// Try again after the quiet period
+		m_firstChange = m_lastChange = micros;
+	}
+}
+
+// Write everything pending to the EEPROM now, at boot and from the console
+void journal_Compact(void) {
+	while (journal_Pending()) {
+		if (!journal_FlushStep()) {
+			break;
+		}
+	}
+}
+
+// Records not in the history yet
+uint8_t journal_Count(void) {
+	return m_journalCount - m_journalFlushed;
+}
+
+// Record from the journal, 0 is the oldest
+uint8_t journal_Get(uint8_t index, historyData_t *data) {
+	if (index >= journal_Count()) {
+		return false;
+	}
+	*data = m_journalRecords[m_journalFlushed + index];
+	return true;
+}
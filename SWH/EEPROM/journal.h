@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file		journal.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __JOURNAL_H
+#define __JOURNAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "eeprom.h"
+#include "history.h"
+#include "config.h"
+#include "ds1307.h"
+
+/** Defines ----------------------------------------------------------------- */
+#define JOURNAL_MAGIC				0x4A
+
+// Layout of the journal in the DS1307 RAM
+#define JOURNAL_MAGIC_OFFSET		0
+#define JOURNAL_SEQUENCE_OFFSET		1	// history sequence of the first record
+#define JOURNAL_DELTA_OFFSET		3	// deltaPlus, deltaMinus
+#define JOURNAL_COUNT_OFFSET		5	// records in the journal
+#define JOURNAL_RECORDS_OFFSET		6
+
+#define JOURNAL_MAX_RECORDS			((DS1307_RAM_SIZE - JOURNAL_RECORDS_OFFSET) \
+										/ sizeof(historyData_t))
+
+// Pending changes are written once nothing changed for the quiet period,
+// or at the deadline after the first one
+#define JOURNAL_QUIET_PERIOD		TIME(2)
+#define JOURNAL_DEADLINE			TIME(30)
+#define JOURNAL_TASK_PERIOD			TIME(0.01)
+
+/** Public function prototypes ---------------------------------------------- */
+void journal_Replay(void);
+void journal_AddHistory(const historyData_t *data);
+void journal_SetDelta(uint8_t deltaPlus, uint8_t deltaMinus);
+void journal_Task(void);
+void journal_Compact(void);
+uint8_t journal_Count(void);
+uint8_t journal_Get(uint8_t index, historyData_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __JOURNAL_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -0,0 +1,214 @@
+/**
+ ******************************************************************************
+ * @file		record.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Compact encoding of the history records.
+ *
+ * A key record holds everything and is decoded on its own, a delta record
+ * holds the changes from the record before it:
+ *  - header byte with the pump status bits, the size of the time delta and
+ *    a flag for every temperature stored as an absolute value
+ *  - seconds since the record before, 1 to 3 bytes
+ *  - 5 bit signed changes of the collector, water heater and boiler
+ *    temperature in two bytes, left out if all three are absolute
+ *  - temperatures that changed more than a delta holds, 2 bytes each
+ *  - check byte, the low byte of the CRC-16 seeded with the key sequence,
+ *    so a torn record or one left from before doesn't decode
+ * A record a few minutes and a few degrees from the one before takes 6
+ * bytes instead of 12. The reserved status bits and the reserved byte are
+ * not kept, they read back as 0.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "record.h"
+#include "crc16.h"
+#include "defines.h"
+#include "systemTicks.h"
+#include "debugUsart.h"
+
+/** Private functions ------------------------------------------------------- */
+static void record_Put16(uint8_t *out, uint16_t value) {
+	out[0] = value & 0xFF;
+	out[1] = value >> 8;
+}
+
+static uint16_t record_Get16(const uint8_t *in) {
+	return in[0] | in[1] << 8;
+}
+
+/** Public functions -------------------------------------------------------- */
+uint8_t record_EncodeKey(uint16_t sequence, const historyData_t *data,
+		uint8_t *out) {
+	record_Put16(&out[0], sequence);
+	record_Put16(&out[2], data->timestamp & 0xFFFF);
+	record_Put16(&out[4], data->timestamp >> 16);
+	out[6] = data->status.B & RECORD_STATUS_MASK;
+	record_Put16(&out[7], data->tempCollector);
+	record_Put16(&out[9], data->tempWaterHeater);
+	record_Put16(&out[11], data->tempBoiler);
+	record_Put16(&out[13], crc16(out, RECORD_KEY_SIZE - 2));
+	return RECORD_KEY_SIZE;
+}
+
+// Key record, 0 if the CRC doesn't match
+uint8_t record_DecodeKey(const uint8_t *in, uint16_t *sequence,
+		historyData_t *data) {
+	if (record_Get16(&in[13]) != crc16(in, RECORD_KEY_SIZE - 2)) {
+		return 0;
+	}
+	*sequence = record_Get16(&in[0]);
+	data->timestamp = record_Get16(&in[2]) | (uint32_t) record_Get16(&in[4])
+			<< 16;
+	data->status.B = in[6];
+	data->reserved = 0;
+	data->tempCollector = record_Get16(&in[7]);
+	data->tempWaterHeater = record_Get16(&in[9]);
+	data->tempBoiler = record_Get16(&in[11]);
+	return RECORD_KEY_SIZE;
+}
+
+// Delta record from the one before, 0 if it takes a key record
+uint8_t record_Encode(uint16_t key, const historyData_t *previous,
+		const historyData_t *data, uint8_t *out) {
+	int16_t current[3] = { data->tempCollector, data->tempWaterHeater,
+			data->tempBoiler };
+	int16_t before[3] = { previous->tempCollector, previous->tempWaterHeater,
+			previous->tempBoiler };
+	uint32_t time;
+	uint16_t deltas = 0;
+	uint8_t header, timeBytes, len, i;
+	int16_t delta;
+
+	if (data->timestamp < previous->timestamp) {
+		return 0;
+	}
+	time = data->timestamp - previous->timestamp;
+	timeBytes = time < 0x100 ? 1 : time < 0x10000 ? 2 : 3;
+	if (time >= 0x1000000) {
+		return 0;
+	}
+
+	header = (data->status.B & RECORD_STATUS_MASK)
+			| (timeBytes - 1) << RECORD_TIME_SHIFT;
+	for (i = 0; i < 3; i++) {
+		delta = current[i] - before[i];
+		if (delta < RECORD_DELTA_MIN || delta > RECORD_DELTA_MAX) {
+			header |= 1 << (RECORD_ABSOLUTE_SHIFT + i);
+		} else {
+			deltas |= (delta & 0x1F) << (5 * i);
+		}
+	}
+
+	out[0] = header;
+	len = 1;
+	for (i = 0; i < timeBytes; i++) {
+		out[len++] = time >> (8 * i);
+	}
+	if ((header >> RECORD_ABSOLUTE_SHIFT) != 0x07) {
+		record_Put16(&out[len], deltas);
+		len += 2;
+	}
+	for (i = 0; i < 3; i++) {
+		if (header & (1 << (RECORD_ABSOLUTE_SHIFT + i))) {
+			record_Put16(&out[len], current[i]);
+			len += 2;
+		}
+	}
+	out[len] = crc16_Update(key, out, len);
+	return len + 1;
+}
+
+// Delta record after the one before, 0 at the end of the records, when
+// the record doesn't fit in len or it is torn
+uint8_t record_Decode(uint16_t key, const historyData_t *previous,
+		const uint8_t *in, uint8_t len, historyData_t *data) {
+	int16_t current[3] = { previous->tempCollector, previous->tempWaterHeater,
+			previous->tempBoiler };
+	uint8_t header = in[0];
+	uint8_t timeBytes = ((header & RECORD_TIME_MASK) >> RECORD_TIME_SHIFT) + 1;
+	uint8_t size, i, pos;
+	uint16_t deltas = 0;
+	uint32_t time = 0;
+	int16_t delta;
+
+	if (timeBytes - 1 == RECORD_TIME_END) {
+		return 0;
+	}
+
+	// whole record has to be there before anything is read from it
+	size = 1 + timeBytes + 1;
+	if ((header >> RECORD_ABSOLUTE_SHIFT) != 0x07) {
+		size += 2;
+	}
+	for (i = 0; i < 3; i++) {
+		if (header & (1 << (RECORD_ABSOLUTE_SHIFT + i))) {
+			size += 2;
+		}
+	}
+	if (size > len || in[size - 1] != (uint8_t) crc16_Update(key, in, size - 1)) {
+		return 0;
+	}
+
+	pos = 1;
+	for (i = 0; i < timeBytes; i++) {
+		time |= (uint32_t) in[pos++] << (8 * i);
+	}
+	if ((header >> RECORD_ABSOLUTE_SHIFT) != 0x07) {
+		deltas = record_Get16(&in[pos]);
+		pos += 2;
+	}
+	for (i = 0; i < 3; i++) {
+		if (header & (1 << (RECORD_ABSOLUTE_SHIFT + i))) {
+			current[i] = record_Get16(&in[pos]);
+			pos += 2;
+		} else {
+			// sign extend the 5 bit delta
+			delta = (deltas >> (5 * i)) & 0x1F;
+			current[i] += delta >= 0x10 ? delta - 0x20 : delta;
+		}
+	}
+
+	data->timestamp = previous->timestamp + time;
+	data->status.B = header & RECORD_STATUS_MASK;
+	data->reserved = 0;
+	data->tempCollector = current[0];
+	data->tempWaterHeater = current[1];
+	data->tempBoiler = current[2];
+	return size;
+}
+
+// Print the cost in CPU cycles of encoding and decoding a typical record
+void record_Benchmark(void) {
+	historyData_t previous, data, decoded;
+	uint8_t buffer[RECORD_MAX_SIZE];
+	uint32_t start, encode, decode;
+	uint8_t len;
+
+	memset(&previous, 0, sizeof(previous));
+	previous.timestamp = 846000000;
+	previous.tempCollector = 64;
+	previous.tempWaterHeater = 48;
+	previous.tempBoiler = 55;
+	data = previous;
+	data.timestamp += 420;
+	data.status.bits.collectorPump = 1;
+	data.tempCollector -= 3;
+	data.tempWaterHeater += 1;
+
+	InitCycleCounter();
+	start = CYCLES();
+	len = record_Encode(0x1234, &previous, &data, buffer);
+	encode = CYCLES() - start;
+	start = CYCLES();
+	record_Decode(0x1234, &previous, buffer, len, &decoded);
+	decode = CYCLES() - start;
+
+	debug.printf("Record: %u of %u bytes, encode %u, decode %u cycles\r\n",
+			len, sizeof(historyData_t), encode, decode);
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
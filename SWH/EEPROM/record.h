@@ -0,0 +1,58 @@
+/**
+ ******************************************************************************
+ * @file		record.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __RECORD_H
+#define __RECORD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "eeprom.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Key record: sequence, timestamp, status, three temperatures and CRC-16
+#define RECORD_KEY_SIZE				15
+
+// Header byte of a delta record
+#define RECORD_STATUS_MASK			0x07	// boiler, collector pump, nRF
+#define RECORD_TIME_SHIFT			3		// bytes of the time delta - 1
+#define RECORD_TIME_MASK			0x18
+#define RECORD_ABSOLUTE_SHIFT		5		// temperature is absolute, one
+											// bit for each, collector first
+// Time delta size 3 is never written, erased EEPROM ends the records
+#define RECORD_TIME_END				3
+
+// Temperature change a delta record holds, five bits
+#define RECORD_DELTA_MIN			(-16)
+#define RECORD_DELTA_MAX			15
+
+// Header, three byte time delta, temperature deltas, three absolute
+// temperatures and the check byte
+#define RECORD_MAX_SIZE				13
+
+/** Public function prototypes ---------------------------------------------- */
+uint8_t record_EncodeKey(uint16_t sequence, const historyData_t *data,
+		uint8_t *out);
+uint8_t record_DecodeKey(const uint8_t *in, uint16_t *sequence,
+		historyData_t *data);
+uint8_t record_Encode(uint16_t key, const historyData_t *previous,
+		const historyData_t *data, uint8_t *out);
+uint8_t record_Decode(uint16_t key, const historyData_t *previous,
+		const uint8_t *in, uint8_t len, historyData_t *data);
+void record_Benchmark(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __RECORD_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
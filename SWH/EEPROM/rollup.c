@@ -0,0 +1,292 @@
+/**
+ ******************************************************************************
+ * @file		rollup.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Hourly and daily summaries of the temperatures and pumps.
+ *
+ * Every sample is added to the open hour and the open day in RAM: minimum,
+ * maximum and time weighted mean of each temperature, the seconds the
+ * pumps were on and the seconds the collector link was up. A closed period
+ * is written to its slot at the end of the EEPROM, the slot is the period
+ * number modulo the slots kept, so the hour or the day age periods ago is
+ * one read and the oldest one is overwritten by itself.
+ *
+ * The open hour is also saved every ROLLUP_SAVE_PERIOD, at boot it is
+ * picked up from its slot and the open day is added up from the hours of
+ * today. Writes are queued and go out one per sample, only when the EEPROM
+ * is done with the write before, the same way the journal does it.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <stddef.h>
+#include <string.h>
+#include "rollup.h"
+#include "crc16.h"
+#include "defines.h"
+#include "debugUsart.h"
+
+/** Private variables ------------------------------------------------------- */
+static const uint32_t m_rollupLength[ROLLUP_PERIODS] = { ROLLUP_HOUR_SECONDS,
+		ROLLUP_DAY_SECONDS };
+static const uint16_t m_rollupSlots[ROLLUP_PERIODS] = { ROLLUP_HOURS,
+		ROLLUP_DAYS };
+static const uint16_t m_rollupFirstSlot[ROLLUP_PERIODS] = { 0, ROLLUP_HOURS };
+
+static rollup_t m_rollupOpen[ROLLUP_PERIODS];
+// Temperature times seconds and seconds it was valid, for the mean
+static int32_t m_rollupSum[ROLLUP_PERIODS][ROLLUP_TEMPS];
+static uint32_t m_rollupTime[ROLLUP_PERIODS][ROLLUP_TEMPS];
+static uint32_t m_rollupLast;		// timestamp of the last sample
+static uint32_t m_rollupSaved;		// timestamp the open hour was saved
+
+static rollup_t m_rollupQueue[ROLLUP_QUEUE_SIZE];
+static uint32_t m_rollupQueueAddr[ROLLUP_QUEUE_SIZE];
+static uint8_t m_rollupQueued;
+
+/** Private functions ------------------------------------------------------- */
+static uint32_t rollup_Address(uint8_t period, uint32_t start) {
+	return ROLLUP_START
+			+ (m_rollupFirstSlot[period]
+					+ (start / m_rollupLength[period]) % m_rollupSlots[period])
+					* ROLLUP_SLOT_SIZE;
+}
+
+// Period starting at start from its slot, false if the slot holds another
+// one or it is torn
+static uint8_t rollup_Read(uint8_t period, uint32_t start, rollup_t *rollup) {
+	if (!blockdev_Read(rollup_Address(period, start), (uint8_t *) rollup,
+			ROLLUP_SLOT_SIZE)) {
+		return false;
+	}
+	return rollup->crc == crc16((uint8_t *) rollup, offsetof(rollup_t, crc))
+			&& rollup->start == start;
+}
+
+static void rollup_Reset(uint8_t period, uint32_t start) {
+	memset(&m_rollupOpen[period], 0, sizeof(rollup_t));
+	memset(m_rollupSum[period], 0, sizeof(m_rollupSum[period]));
+	memset(m_rollupTime[period], 0, sizeof(m_rollupTime[period]));
+	m_rollupOpen[period].start = start;
+}
+
+static void rollup_Mean(uint8_t period, uint8_t i) {
+	int32_t sum = m_rollupSum[period][i];
+	int32_t time = m_rollupTime[period][i];
+
+	if (time > 0) {
+		// rounded, not towards zero
+		m_rollupOpen[period].mean[i] =
+				(sum + (sum < 0 ? -time : time) / 2) / time;
+	}
+}
+
+// Temperature into the minimum, maximum and the mean, for seconds
+static void rollup_AddTemperature(uint8_t period, uint8_t i, int8_t min,
+		int8_t max, int8_t mean, uint32_t seconds) {
+	rollup_t *open = &m_rollupOpen[period];
+
+	if (!(open->valid & (1 << i))) {
+		open->min[i] = min;
+		open->max[i] = max;
+		open->mean[i] = mean;
+		open->valid |= 1 << i;
+	}
+	if (min < open->min[i]) {
+		open->min[i] = min;
+	}
+	if (max > open->max[i]) {
+		open->max[i] = max;
+	}
+	m_rollupSum[period][i] += (int32_t) mean * (int32_t) seconds;
+	m_rollupTime[period][i] += seconds;
+	rollup_Mean(period, i);
+}
+
+// Shorter period from the EEPROM into the open one
+static void rollup_Merge(uint8_t period, const rollup_t *rollup) {
+	rollup_t *open = &m_rollupOpen[period];
+	uint8_t i;
+
+	open->seconds += rollup->seconds;
+	open->boilerPump += rollup->boilerPump;
+	open->collectorPump += rollup->collectorPump;
+	open->link += rollup->link;
+	for (i = 0; i < ROLLUP_TEMPS; i++) {
+		if (rollup->valid & (1 << i)) {
+			rollup_AddTemperature(period, i, rollup->min[i], rollup->max[i],
+					rollup->mean[i], rollup->seconds);
+		}
+	}
+}
+
+// Open period to be written, replaces a save of the same period not
+// written yet, the oldest write is dropped when the EEPROM doesn't take them
+static void rollup_Queue(uint8_t period) {
+	uint32_t addr = rollup_Address(period, m_rollupOpen[period].start);
+	uint8_t i;
+
+	for (i = 0; i < m_rollupQueued; i++) {
+		if (m_rollupQueueAddr[i] == addr
+				&& m_rollupQueue[i].start == m_rollupOpen[period].start) {
+			break;
+		}
+	}
+	if (i == ROLLUP_QUEUE_SIZE) {
+		memmove(&m_rollupQueue[0], &m_rollupQueue[1],
+				(ROLLUP_QUEUE_SIZE - 1) * sizeof(rollup_t));
+		memmove(&m_rollupQueueAddr[0], &m_rollupQueueAddr[1],
+				(ROLLUP_QUEUE_SIZE - 1) * sizeof(uint32_t));
+		i--;
+	} else if (i == m_rollupQueued) {
+		m_rollupQueued++;
+	}
+
+	m_rollupQueue[i] = m_rollupOpen[period];
+	m_rollupQueue[i].crc = crc16((uint8_t *) &m_rollupQueue[i],
+			offsetof(rollup_t, crc));
+	m_rollupQueueAddr[i] = addr;
+}
+
+// Oldest queued write, false if it didn't go
+static uint8_t rollup_WriteStep(uint8_t wait) {
+	if (!blockdev_Write(m_rollupQueueAddr[0], (uint8_t *) &m_rollupQueue[0],
+			ROLLUP_SLOT_SIZE, wait)) {
+		return false;
+	}
+	m_rollupQueued--;
+	memmove(&m_rollupQueue[0], &m_rollupQueue[1],
+			m_rollupQueued * sizeof(rollup_t));
+	memmove(&m_rollupQueueAddr[0], &m_rollupQueueAddr[1],
+			m_rollupQueued * sizeof(uint32_t));
+	return true;
+}
+
+/** Public functions -------------------------------------------------------- */
+// Open the hour and the day now is in, called once at boot
+void rollup_Mount(uint32_t now) {
+	rollup_t rollup;
+	uint32_t start;
+	uint8_t period, hours = 0;
+
+	m_rollupQueued = 0;
+	m_rollupLast = 0;
+	m_rollupSaved = now;
+	for (period = 0; period < ROLLUP_PERIODS; period++) {
+		rollup_Reset(period, now - now % m_rollupLength[period]);
+	}
+
+	// Hour as it was saved last
+	if (rollup_Read(ROLLUP_HOUR, m_rollupOpen[ROLLUP_HOUR].start, &rollup)) {
+		rollup_Merge(ROLLUP_HOUR, &rollup);
+	}
+	// Day from the hours before, and the open hour
+	for (start = m_rollupOpen[ROLLUP_DAY].start;
+			start <= m_rollupOpen[ROLLUP_HOUR].start; start +=
+					ROLLUP_HOUR_SECONDS) {
+		if (rollup_Read(ROLLUP_HOUR, start, &rollup)) {
+			rollup_Merge(ROLLUP_DAY, &rollup);
+			hours++;
+		}
+	}
+
+	debug.printf("Rollups: %d hours of today\r\n", hours);
+}
+
+// Add the state at data->timestamp, valid has a bit for each temperature
+// that can be used, called every second
+void rollup_Sample(const historyData_t *data, uint8_t valid) {
+	int16_t temperature[ROLLUP_TEMPS] = { data->tempCollector,
+			data->tempWaterHeater, data->tempBoiler };
+	uint32_t now = data->timestamp, seconds = 0;
+	rollup_t *open;
+	uint8_t period, i;
+
+	// Time since the last sample goes to the state it ends with
+	if (m_rollupLast != 0 && now > m_rollupLast
+			&& now - m_rollupLast <= ROLLUP_MAX_GAP) {
+		seconds = now - m_rollupLast;
+	}
+	m_rollupLast = now;
+
+	for (period = 0; period < ROLLUP_PERIODS; period++) {
+		open = &m_rollupOpen[period];
+		if (now - now % m_rollupLength[period] != open->start) {
+			// Period is over, or the clock was set
+			if (open->seconds) {
+				rollup_Queue(period);
+			}
+			rollup_Reset(period, now - now % m_rollupLength[period]);
+		}
+
+		open->seconds += seconds;
+		if (data->status.bits.boilerPump) {
+			open->boilerPump += seconds;
+		}
+		if (data->status.bits.collectorPump) {
+			open->collectorPump += seconds;
+		}
+		if (data->status.bits.nRFComm) {
+			open->link += seconds;
+		}
+		for (i = 0; i < ROLLUP_TEMPS; i++) {
+			if (valid & (1 << i)) {
+				rollup_AddTemperature(period, i, temperature[i],
+						temperature[i], temperature[i], seconds);
+			}
+		}
+	}
+
+	if (now - m_rollupSaved >= ROLLUP_SAVE_PERIOD) {
+		rollup_Queue(ROLLUP_HOUR);
+		m_rollupSaved = now;
+	}
+	if (m_rollupQueued && blockdev_IsReady()) {
+		rollup_WriteStep(false);
+	}
+}
+
+// Write the open hour and everything queued now
+void rollup_Save(void) {
+	rollup_Queue(ROLLUP_HOUR);
+	m_rollupSaved = m_rollupLast;
+	while (m_rollupQueued) {
+		if (!rollup_WriteStep(true)) {
+			break;
+		}
+	}
+}
+
+// Open hour or day, up to the last sample
+const rollup_t *rollup_Current(uint8_t period) {
+	return &m_rollupOpen[period];
+}
+
+// Hour or day age periods before the open one, 0 is the open one, false
+// if there is none
+uint8_t rollup_Get(uint8_t period, uint16_t age, rollup_t *rollup) {
+	uint32_t start;
+	uint8_t i;
+
+	if (age >= m_rollupSlots[period]) {
+		return false;
+	}
+	if (age == 0) {
+		*rollup = m_rollupOpen[period];
+		return true;
+	}
+
+	start = m_rollupOpen[period].start - age * m_rollupLength[period];
+	for (i = 0; i < m_rollupQueued; i++) {
+		if (m_rollupQueue[i].start == start
+				&& m_rollupQueueAddr[i] == rollup_Address(period, start)) {
+			*rollup = m_rollupQueue[i];
+			return true;
+		}
+	}
+	return rollup_Read(period, start, rollup);
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
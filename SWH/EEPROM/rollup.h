@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @file		rollup.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __ROLLUP_H
+#define __ROLLUP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "eeprom.h"
+#include "blockdev.h"
+
+/** Defines ----------------------------------------------------------------- */
+#define ROLLUP_HOUR					0
+#define ROLLUP_DAY					1
+#define ROLLUP_PERIODS				2
+
+// Periods kept in the EEPROM, the slot of a period is its number modulo
+// this, so the period age ago is found without a search
+#define ROLLUP_HOURS				24
+#define ROLLUP_DAYS					16
+
+#define ROLLUP_HOUR_SECONDS			3600UL
+#define ROLLUP_DAY_SECONDS			86400UL
+
+// Collector, water heater and boiler, bit in valid in the same order
+#define ROLLUP_TEMPS				3
+
+// At the end of the EEPROM, hours first
+#define ROLLUP_SLOT_SIZE			sizeof(rollup_t)
+#define ROLLUP_START				(blockdev_Size() - (ROLLUP_HOURS \
+										+ ROLLUP_DAYS) * ROLLUP_SLOT_SIZE)
+
+// Open hour is saved this often, a reset loses at most this much of it
+#define ROLLUP_SAVE_PERIOD			600
+// Longer time between two samples isn't counted, the board was off
+#define ROLLUP_MAX_GAP				10
+
+// Writes waiting for the EEPROM
+#define ROLLUP_QUEUE_SIZE			4
+
+// 32 bytes, a slot is one page of the AT24C32
+typedef struct {
+	uint32_t start;					// timestamp the period starts at
+	uint32_t seconds;				// seconds sampled in the period
+	uint32_t boilerPump;			// seconds the pumps were on
+	uint32_t collectorPump;
+	uint32_t link;					// seconds the nRF link was up
+	int8_t min[ROLLUP_TEMPS];
+	int8_t max[ROLLUP_TEMPS];
+	int8_t mean[ROLLUP_TEMPS];		// over the time a temperature was valid
+	uint8_t valid;					// bit for each temperature with samples
+	uint16_t crc;					// CRC-16 of everything above
+} rollup_t;
+
+/** Public function prototypes ---------------------------------------------- */
+void rollup_Mount(uint32_t now);
+void rollup_Sample(const historyData_t *data, uint8_t valid);
+void rollup_Save(void);
+const rollup_t *rollup_Current(uint8_t period);
+uint8_t rollup_Get(uint8_t period, uint16_t age, rollup_t *rollup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __ROLLUP_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
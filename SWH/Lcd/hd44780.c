@@ -16,12 +16,17 @@
 #include "stm32f10x.h"
 #include "hd44780.h"
 #include "systemTicks.h"
+#include "defines.h"
 
 #define LCD_Port GPIOA
 
 #define RS GPIO_Pin_0
 #define EN GPIO_Pin_1
+// R/W line, leave undefined when it is tied to GND
+//#define RW GPIO_Pin_6
 
+// D4-D7 must be four consecutive pins of LCD_Port, they are set with one write
+#define LCD_DATA_SHIFT 2
 #define D4 GPIO_Pin_2
 #define D5 GPIO_Pin_3
 #define D6 GPIO_Pin_4
@@ -36,41 +41,85 @@
 #define BLINK _OFF // Valid option are ON or OFF
 #define NUMLINES _TWO_LINES // Valid options are ONE_LINE or TWO_LINES
 
+#define LCD_ROWS 4
+#define LCD_COLUMNS 20
+
+// Execution times in us (datasheet: 37 us, 1.52 ms for clear and home)
+#define LCD_EXEC_TIME 50
+#define LCD_EXEC_TIME_LONG 2000
+#define LCD_NO_ADDRESS 0xFF
+
 char customChar[8] = { 0b01000, 0b10100, 0b01000, 0b00011, 0b00100, 0b00100, 0b00100, 0b00011 };
 
+// What the display shows, only characters that differ are sent
+static char Shadow[LCD_ROWS][LCD_COLUMNS];
+// DDRAM address counter of the display, LCD_NO_ADDRESS if not known
+static uint8_t Cursor = LCD_NO_ADDRESS;
+static const uint8_t RowAddress[LCD_ROWS] = { 0x00, 0x40, 0x14, 0x54 };
+
+#ifndef RW
+// Last instruction and how long it takes, checked before the next one
+static uint32_t lastWrite;
+static uint32_t execTime;
+#endif
+
 /**
- * Strobe EN pin
+ * EN high and low time, at least 450 ns at 72 MHz
  */
-void strobeEN(void) {
-	GPIO_SetBits(LCD_Port, EN);
-	_DelayUS(100);
-	GPIO_ResetBits(LCD_Port, EN);
-	_DelayUS(100);
+static inline void lcdPulseDelay(void) {
+	uint8_t i;
+	for (i = 0; i < 12; i++)
+		__NOP();
 }
 
 /**
  * Used for 4-bit mode operation
  * @param nibble 4 bits of data to send to lcd
+ * @param type RS pin depends on data type if command or not
  */
-void lcdNibble(uint8_t nibble) {
-	if (nibble & 0x8)
-		GPIO_SetBits(LCD_Port, D7);
-	else
-		GPIO_ResetBits(LCD_Port, D7);
-	if (nibble & 0x4)
-		GPIO_SetBits(LCD_Port, D6);
-	else
-		GPIO_ResetBits(LCD_Port, D6);
-	if (nibble & 0x2)
-		GPIO_SetBits(LCD_Port, D5);
-	else
-		GPIO_ResetBits(LCD_Port, D5);
-	if (nibble & 0x1)
-		GPIO_SetBits(LCD_Port, D4);
-	else
-		GPIO_ResetBits(LCD_Port, D4);
+static void lcdNibble(uint8_t nibble, LCD_REGISTER_TYPE type) {
+	// Data lines and RS in one write, upper half of BSRR resets
+	LCD_Port->BSRR = ((uint32_t) (~nibble & 0x0F) << (LCD_DATA_SHIFT + 16))
+			| ((uint32_t) (nibble & 0x0F) << LCD_DATA_SHIFT)
+			| (type == DATA ? RS : (uint32_t) RS << 16);
+	lcdPulseDelay();
+	LCD_Port->BSRR = EN;
+	lcdPulseDelay();
+	LCD_Port->BRR = EN;
+}
 
-	strobeEN();
+/**
+ * Wait until the LCD can take the next instruction
+ */
+static void lcdWaitReady(void) {
+#ifdef RW
+	uint8_t busy;
+	uint32_t start = micros;
+
+	// D4-D7 floating inputs while the LCD drives them
+	LCD_Port->CRL = (LCD_Port->CRL & ~(0xFFFF << (LCD_DATA_SHIFT * 4)))
+			| (0x4444 << (LCD_DATA_SHIFT * 4));
+	LCD_Port->BSRR = RW | ((uint32_t) RS << 16);
+	do {
+		// Busy flag is D7 of the high nibble, low nibble is the address
+		LCD_Port->BSRR = EN;
+		lcdPulseDelay();
+		busy = (LCD_Port->IDR & D7) != 0;
+		LCD_Port->BRR = EN;
+		lcdPulseDelay();
+		LCD_Port->BSRR = EN;
+		lcdPulseDelay();
+		LCD_Port->BRR = EN;
+		lcdPulseDelay();
+	} while (busy && !TIMEOUT(start, LCD_EXEC_TIME_LONG));
+	LCD_Port->BRR = RW;
+	// Back to push-pull outputs, 10 MHz
+	LCD_Port->CRL = (LCD_Port->CRL & ~(0xFFFF << (LCD_DATA_SHIFT * 4)))
+			| (0x1111 << (LCD_DATA_SHIFT * 4));
+#else
+	while (!TIMEOUT(lastWrite, execTime))
+		;
+#endif
 }
 
 /**
@@ -78,15 +127,40 @@ void lcdNibble(uint8_t nibble) {
  * @param byte 8-bit data
  * @param type RS pin depends on data type if command or not
  */
-void lcdWrite(uint8_t byte, LCD_REGISTER_TYPE type) {
-	GPIO_ResetBits(LCD_Port, EN);
-	if (type == COMMAND) // check expected data type
-		GPIO_ResetBits(LCD_Port, RS); // sending special commands (see hd44780 datasheet)
+static void lcdWrite(uint8_t byte, LCD_REGISTER_TYPE type) {
+	lcdWaitReady();
+	lcdNibble((uint8_t)(byte >> 4), type); // send higher 4-bits
+	lcdNibble((uint8_t)(byte & 0x0F), type); // send lower 4-bits
+#ifndef RW
+	lastWrite = micros;
+	if (type == COMMAND && (byte == LCD_CLEAR || byte == LCD_RETURN_HOME))
+		execTime = LCD_EXEC_TIME_LONG;
 	else
-		GPIO_SetBits(LCD_Port, RS); // assume actual data
+		execTime = LCD_EXEC_TIME;
+#endif
+}
 
-	lcdNibble((uint8_t)(byte >> 4)); // send higher 4-bits
-	lcdNibble((uint8_t)(byte & 0x0F)); // send lower 4-bits
+/**
+ * Put character on row/column (0 based) if it is not there already
+ */
+static void lcdPut(uint8_t row, uint8_t col, char ch) {
+	uint8_t address;
+
+	if (row >= LCD_ROWS || col >= LCD_COLUMNS || Shadow[row][col] == ch)
+		return;
+
+	address = RowAddress[row] + col;
+	if (address != Cursor)
+		lcdWrite(0x80 | address, COMMAND); // set DDRAM address
+	lcdWrite(ch, DATA);
+	Shadow[row][col] = ch;
+
+	// Address counter goes on to the next line at the end of a line
+	Cursor = address + 1;
+	if (Cursor == 0x28)
+		Cursor = 0x40;
+	else if (Cursor == 0x68)
+		Cursor = 0x00;
 }
 
 void initLCD(void) {
@@ -95,118 +169,68 @@ void initLCD(void) {
 	RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA, ENABLE);
 
 	GPIO_InitStructure.GPIO_Pin = EN | RS | D4 | D5 | D6 | D7;
-	GPIO_ResetBits(LCD_Port, EN | RS | D4 | D5 | D6 | D7);
+#ifdef RW
+	GPIO_InitStructure.GPIO_Pin |= RW;
+#endif
+	GPIO_ResetBits(LCD_Port, GPIO_InitStructure.GPIO_Pin);
 	GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
 	GPIO_InitStructure.GPIO_Speed = GPIO_Speed_10MHz;
 	GPIO_Init(LCD_Port, &GPIO_InitStructure);
-	GPIO_ResetBits(LCD_Port, EN | RS | D4 | D5 | D6 | D7);
+	GPIO_ResetBits(LCD_Port, GPIO_InitStructure.GPIO_Pin);
 
 	_DelayMS(40);
 	// wait 10ms for lcd internal initialization
 
-	lcdNibble(0b0011); // Function set - Interface defaults to 8-bit mode
+	lcdNibble(0b0011, COMMAND); // Function set - Interface defaults to 8-bit mode
 	_DelayMS(5);
-	lcdNibble(0b0011); // Function set - Interface defaults to 8-bit mode
+	lcdNibble(0b0011, COMMAND); // Function set - Interface defaults to 8-bit mode
 	_DelayMS(5);
-	lcdNibble(0b0011); // Function set - Interface defaults to 8-bit mode
+	lcdNibble(0b0011, COMMAND); // Function set - Interface defaults to 8-bit mode
 	_DelayMS(5);
-	lcdNibble(0b0010); // Now set the interface to 4-bit mode
+	lcdNibble(0b0010, COMMAND); // Now set the interface to 4-bit mode
 	_DelayMS(5);
 
+	// From here on lcdWrite waits until the LCD is ready
 	lcdWrite(((0b0010 << 4) | (NUMLINES << 3)), COMMAND); // 0x28 = 4-bit, 2-line, 5x8 font size
-	_DelayMS(5);
 	lcdWrite(((0b1100) | (CURSOR << 1) | BLINK), COMMAND); // 0x0C = Turn ON display, no cursor, no blinking
-	_DelayMS(8);
-	clearLCD(); // Clear the screen
-	_DelayMS(5);
 	lcdWrite(0x06, COMMAND); // Move from left-to-right, no shifting
-	_DelayMS(5);
-	clearLCD();
-
-	GPIO_SetBits(LCD_Port, RS);
+	clearLCD(); // Clear the screen and the shadow copy
 }
 
 /**
  * Clears the LCD
  */
 void clearLCD(void) {
+	uint8_t row, col;
+
 	lcdWrite(LCD_CLEAR, COMMAND);
-	_DelayMS(2);
+	for (row = 0; row < LCD_ROWS; row++)
+		for (col = 0; col < LCD_COLUMNS; col++)
+			Shadow[row][col] = ' ';
+	Cursor = 0x00;
 }
 
 void lcdChar(uint8_t y, uint8_t x, char Chr) {
-	uint8_t data;
-	switch (y) {
-	case 1:
-		data = (uint8_t)(127 + x);
-		break;
-	case 2:
-		data = (uint8_t)(191 + x);
-		break;
-	case 3:
-		data = (uint8_t)(147 + x);
-		break;
-	case 4:
-		data = (uint8_t)(211 + x);
-		break;
-	default:
-		break;
-	}
-	lcdWrite(data, COMMAND);
-	lcdWrite(Chr, DATA);
+	lcdPut((uint8_t)(y - 1), (uint8_t)(x - 1), Chr);
 }
 
 void lcdPrint(uint8_t y, uint8_t x, char *buffer) {
-	uint8_t data;
-	switch (y) {
-	case 1:
-		data = (uint8_t)(127 + x);
-		break;
-	case 2:
-		data = (uint8_t)(191 + x);
-		break;
-	case 3:
-		data = (uint8_t)(147 + x);
-		break;
-	case 4:
-		data = (uint8_t)(211 + x);
-		break;
-	default:
-		break;
-	}
-	lcdWrite(data, COMMAND);
 	while (*buffer) { // Write data to LCD up to null
-		lcdWrite(*buffer++, DATA);
+		lcdPut((uint8_t)(y - 1), (uint8_t)(x - 1), *buffer++);
+		x++;
 	}
 }
 
-//void lcdPrint2(uint8_t y, uint8_t x, const rom char *buffer) {
-//    uint8_t data;
-//    switch (y) {
-//        case 1: data = 127 + x;
-//            break;
-//        case 2: data = 191 + x;
-//            break;
-//        case 3: data = 147 + x;
-//            break;
-//        case 4: data = 211 + x;
-//            break;
-//        default: break;
-//    }
-//    lcdWrite(data, COMMAND);
-//    while (*buffer) { // Write data to LCD up to null
-//        lcdWrite(*buffer++, DATA);
-//    }
-//}
-
 void CreateCustomChar(char *customChar) {
 	lcdWrite(0x40, COMMAND);
 	while (*customChar) { // Write data to LCD up to null
 		lcdWrite(*customChar++, DATA);
 	}
+	// Address counter now points into CGRAM
+	Cursor = LCD_NO_ADDRESS;
 }
 
-// Print temperature on LCD
+// Print temperature on LCD, only characters that changed are sent
 void hd44780_PrintTemperatures(char *tBoiler, char *tWaterHeater, char *tCollector) {
 	uint8_t x = 1;
 	lcdPrint(1, x + 1, (char *) "BOJ");
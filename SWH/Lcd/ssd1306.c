@@ -7,17 +7,15 @@
  */
 
 /** Includes ---------------------------------------------------------------- */
-#include <math.h>
 #include "stm32f10x.h"
 #include "stm32f10x_gpio.h"
 #include "stm32f10x_i2c.h"
 
 #include "ssd1306.h"
 #include "ssd1306_i2c.h"
+#include "ssd1306_gfx.h"
 #include "defines.h"
 #include "systemTicks.h"
-#include "mainController.h"
-#include "nrf24_mid_level.h"
 
 // Screenbuffer
 static uint8_t SSD1306_Buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
@@ -25,6 +23,35 @@ static uint8_t SSD1306_Buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
 // Screen object
 static SSD1306_t SSD1306;
 
+// Dirty column range of every page, DirtyFirst > DirtyLast means page is clean
+static uint8_t DirtyFirst[SSD1306_HEIGHT / 8];
+static uint8_t DirtyLast[SSD1306_HEIGHT / 8];
+
+// Content scroll that may still be running
+static uint32_t ScrollStart;
+static uint8_t Scrolling;
+
+/** Private functions ------------------------------------------------------- */
+static void ssd1306_ClearDirty(void) {
+	uint8_t i;
+	for (i = 0; i < SSD1306_HEIGHT / 8; i++) {
+		DirtyFirst[i] = SSD1306_WIDTH - 1;
+		DirtyLast[i] = 0;
+	}
+}
+
+// Send columns [first, last] of one page to the screen
+static void ssd1306_WritePage(uint8_t page, uint8_t first, uint8_t last) {
+	uint8_t cmd[3];
+
+	cmd[0] = 0xB0 + page;
+	cmd[1] = 0x00 | (first & 0x0F); // lower column start address
+	cmd[2] = 0x10 | (first >> 4); // higher column start address
+	ssd1306_WriteCommands(cmd, sizeof(cmd));
+	ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH * page + first],
+			last - first + 1);
+}
+
 /** Public functions -------------------------------------------------------- */
 /**
  ******************************************************************************
@@ -44,8 +71,9 @@ void ssd1306_Init() {
 	ssd1306_WriteCommand(0xAE); //display off
 
 	ssd1306_WriteCommand(0x20); //Set Memory Addressing Mode
-	ssd1306_WriteCommand(0x10); // 00,Horizontal Addressing Mode; 01,Vertical Addressing Mode;
+	ssd1306_WriteCommand(0x02); // 00,Horizontal Addressing Mode; 01,Vertical Addressing Mode;
 								// 10,Page Addressing Mode (RESET); 11,Invalid
+								// page mode, ssd1306_WritePage relies on it
 
 	ssd1306_WriteCommand(0xB0); //Set Page Start Address for Page Addressing Mode,0-7
 
@@ -122,15 +150,123 @@ void ssd1306_Fill(SSD1306_COLOR color) {
 	}
 }
 
+// Direct access to the screenbuffer for the drawing primitives
+uint8_t* ssd1306_GetBuffer(void) {
+	return SSD1306_Buffer;
+}
+
 // Write the screenbuffer with changed to the screen
 void ssd1306_UpdateScreen(void) {
 	uint8_t i;
-	for (i = 0; i < 8; i++) {
-		ssd1306_WriteCommand(0xB0 + i);
-		ssd1306_WriteCommand(0x00);
-		ssd1306_WriteCommand(0x10);
-		ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH * i], SSD1306_WIDTH);
+	for (i = 0; i < SSD1306_HEIGHT / 8; i++) {
+		ssd1306_WritePage(i, 0, SSD1306_WIDTH - 1);
 	}
+	ssd1306_ClearDirty();
+}
+
+// Remember that area of the screenbuffer has been changed
+void ssd1306_MarkDirty(int16_t x, int16_t y, int16_t w, int16_t h) {
+	int16_t page, lastPage;
+
+	// Clip to the screen
+	if (x < 0) {
+		w += x;
+		x = 0;
+	}
+	if (y < 0) {
+		h += y;
+		y = 0;
+	}
+	if (x + w > SSD1306_WIDTH) {
+		w = SSD1306_WIDTH - x;
+	}
+	if (y + h > SSD1306_HEIGHT) {
+		h = SSD1306_HEIGHT - y;
+	}
+	if (w <= 0 || h <= 0) {
+		return;
+	}
+
+	lastPage = (y + h - 1) / 8;
+	for (page = y / 8; page <= lastPage; page++) {
+		if (x < DirtyFirst[page]) {
+			DirtyFirst[page] = x;
+		}
+		if (x + w - 1 > DirtyLast[page]) {
+			DirtyLast[page] = x + w - 1;
+		}
+	}
+}
+
+// Write only the changed part of the screenbuffer to the screen
+void ssd1306_UpdateDirty(void) {
+	uint8_t i;
+
+	// Anything written now would be shifted too, keep it for the next pass
+	if (!ssd1306_ScrollDone()) {
+		return;
+	}
+	for (i = 0; i < SSD1306_HEIGHT / 8; i++) {
+		if (DirtyFirst[i] <= DirtyLast[i]) {
+			ssd1306_WritePage(i, DirtyFirst[i], DirtyLast[i]);
+		}
+	}
+	ssd1306_ClearDirty();
+}
+
+// Shift columns [first, last] of pages [startPage, endPage] one column to the
+// left in the display RAM, the screenbuffer is not touched
+void ssd1306_ScrollLeft(uint8_t startPage, uint8_t endPage, uint8_t first,
+		uint8_t last) {
+	uint8_t cmd[8];
+
+	cmd[0] = 0x2D; // content scroll left
+	cmd[1] = 0x00; // dummy
+	cmd[2] = startPage;
+	cmd[3] = 0x01; // dummy
+	cmd[4] = endPage;
+	cmd[5] = 0x00; // dummy
+	cmd[6] = first;
+	cmd[7] = last;
+	ssd1306_WriteCommands(cmd, sizeof(cmd));
+
+	ScrollStart = micros;
+	Scrolling = true;
+}
+
+// True when the display RAM may be written again after ssd1306_ScrollLeft
+uint8_t ssd1306_ScrollDone(void) {
+	if (Scrolling && TIMEOUT(ScrollStart, SSD1306_SCROLL_TIME)) {
+		Scrolling = false;
+	}
+	return !Scrolling;
+}
+
+// Send one column of pages [startPage, endPage] in a single data transfer
+void ssd1306_WriteColumn(uint8_t x, uint8_t startPage, uint8_t endPage) {
+	uint8_t cmd[8];
+	uint8_t data[SSD1306_HEIGHT / 8];
+	uint8_t page;
+
+	for (page = startPage; page <= endPage; page++) {
+		data[page - startPage] = SSD1306_Buffer[SSD1306_WIDTH * page + x];
+	}
+
+	// Vertical addressing inside a one column window
+	cmd[0] = 0x20;
+	cmd[1] = 0x01;
+	cmd[2] = 0x21;
+	cmd[3] = x;
+	cmd[4] = x;
+	cmd[5] = 0x22;
+	cmd[6] = startPage;
+	cmd[7] = endPage;
+	ssd1306_WriteCommands(cmd, sizeof(cmd));
+	ssd1306_WriteData(data, endPage - startPage + 1);
+
+	// Back to the page addressing set by ssd1306_Init
+	cmd[1] = 0x02;
+	ssd1306_WriteCommands(cmd, 2);
 }
 
 //    Draw one pixel in the screenbuffer
@@ -156,12 +292,32 @@ void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color) {
 	}
 }
 
+// Index of ch in the font data, -1 if the font doesn't have it
+static int16_t ssd1306_FindGlyph(char ch, FontDef *Font) {
+	int16_t i;
+
+	if (Font->chars == NULL) {
+		return (ch >= 32 && ch <= 126) ? ch - 32 : -1;
+	}
+	for (i = 0; Font->chars[i]; i++) {
+		if (Font->chars[i] == ch) {
+			return i;
+		}
+	}
+	return -1;
+}
+
 // Draw 1 char to the screen buffer
 // ch         => char om weg te schrijven
 // Font     => Font waarmee we gaan schrijven
 // color     => Black or White
 char ssd1306_WriteChar(char ch, FontDef Font, SSD1306_COLOR color) {
-	uint32_t i, b, j;
+	uint32_t i, j;
+	const uint8_t *ptr = NULL;
+	int16_t glyph;
+	uint8_t byte = 0, mask = 0; // bit-packed
+	uint8_t run = 0, high = 1; // RLE
+	uint8_t on = 1;
 
 	// Check remaining space on current line
 	if (SSD1306_WIDTH <= (SSD1306.CurrentX + Font.FontWidth)
@@ -170,11 +326,44 @@ char ssd1306_WriteChar(char ch, FontDef Font, SSD1306_COLOR color) {
 		return 0;
 	}
 
+	// Characters missing from the font are left blank
+	glyph = ssd1306_FindGlyph(ch, &Font);
+	if (glyph >= 0) {
+		if (Font.offset != NULL) {
+			ptr = &Font.data[Font.offset[glyph]];
+		} else {
+			ptr = &Font.data[glyph
+					* ((Font.FontWidth * Font.FontHeight + 7) / 8)];
+		}
+	}
+
 	// Use the font to write
 	for (i = 0; i < Font.FontHeight; i++) {
-		b = Font.data[(ch - 32) * Font.FontHeight + i];
 		for (j = 0; j < Font.FontWidth; j++) {
-			if ((b << j) & 0x8000) {
+			if (ptr == NULL) {
+				on = 0;
+			} else if (Font.offset != NULL) {
+				// Runs alternate between background and pixels set
+				while (run == 0) {
+					if (high) {
+						run = *ptr >> 4;
+					} else {
+						run = *ptr++ & 0x0F;
+					}
+					high = !high;
+					on = !on;
+				}
+				run--;
+			} else {
+				if (mask == 0) {
+					byte = *ptr++;
+					mask = 0x80;
+				}
+				on = byte & mask;
+				mask >>= 1;
+			}
+
+			if (on) {
 				ssd1306_DrawPixel(SSD1306.CurrentX + j, (SSD1306.CurrentY + i),
 						(SSD1306_COLOR) color);
 			} else {
@@ -213,84 +402,3 @@ void ssd1306_SetCursor(uint8_t x, uint8_t y) {
 	SSD1306.CurrentX = x;
 	SSD1306.CurrentY = y;
 }
-
-// Print time on LCD
-void ssd1306_PrintDateAndTime(char *date, char *time) {
-	ssd1306_Fill(Black);
-
-	ssd1306_SetCursor(18, 0);
-	ssd1306_WriteString("DATUM I VREME", Font_7x10, White);
-	ssd1306_SetCursor(18, 16);
-	ssd1306_WriteString(date, Font_11x18, White);
-	ssd1306_SetCursor(18, 38);
-	ssd1306_WriteString(time, Font_11x18, White);
-
-	ssd1306_UpdateScreen();
-}
-
-void ssd1306_DrawCircle(int16_t x0, int16_t y0, int16_t radius) {
-	for (int16_t x = 0; x <= 2 * radius; x++) {
-		for (int16_t y = 0; y <= 2 * radius; y++) {
-			double distance = sqrt(
-					(double) (x - radius) * (x - radius)
-							+ (y - radius) * (y - radius));
-			if (distance > radius - 0.5 && distance < radius + 0.5) {
-				ssd1306_DrawPixel(x0 + x - radius, y0 + y - radius, White);
-			}
-		}
-	}
-}
-
-void ssd1306_FillCircle(int16_t x0, int16_t y0, int16_t radius) {
-	for (int16_t y = -radius; y <= radius; y++) {
-		for (int16_t x = -radius; x <= radius; x++) {
-			if (x * x + y * y <= radius * radius) {
-				ssd1306_DrawPixel(x0 + x, y0 + y, White);
-			}
-		}
-	}
-}
-
-// Print temperatures on LCD
-void ssd1306_PrintTemperatures(char *tBoiler, char *tWaterHeater,
-		char *tCollector) {
-	ssd1306_Fill(Black);
-
-	// Kotao
-	ssd1306_SetCursor(92, 0);
-	ssd1306_WriteString("KOTAO", Font_7x10, White);
-	ssd1306_SetCursor(92, 16);
-	ssd1306_WriteString(tBoiler, Font_11x18, White);
-	if (m_boilerPump) {
-		ssd1306_FillCircle(108, 48, 10);
-	} else {
-		ssd1306_DrawCircle(108, 48, 10);
-	}
-
-	// Bojler
-	ssd1306_SetCursor(44, 0);
-	ssd1306_WriteString("BOJLER", Font_7x10, White);
-	ssd1306_SetCursor(40, 24);
-	ssd1306_WriteString(tWaterHeater, Font_16x26, White);
-
-	// Kolektor
-	ssd1306_SetCursor(2, 0);
-	ssd1306_WriteString("KOLEK", Font_7x10, White);
-	ssd1306_SetCursor(2, 16);
-	if (nrf24Data.connected) {
-		ssd1306_WriteString(tCollector, Font_11x18, White);
-		if (TIMEOUT(nrf24Data.timeout, NRF24_TIMEOUT)) {
-			nrf24Data.connected = false;
-		}
-	} else {
-		ssd1306_WriteString(" --", Font_11x18, White);
-	}
-	if (m_collectorPump) {
-		ssd1306_FillCircle(16, 48, 10);
-	} else {
-		ssd1306_DrawCircle(16, 48, 10);
-	}
-
-	ssd1306_UpdateScreen();
-}
-
@@ -30,6 +30,15 @@ extern "C" {
 // some LEDs don't display anything in first two columns
 // #define SSD1306_WIDTH           130
 
+// Use the content scroll command (2Dh) to shift part of the screen by one
+// column, set to 0 for clones that don't have it
+#ifndef SSD1306_CONTENT_SCROLL
+#define SSD1306_CONTENT_SCROLL  1
+#endif
+
+// Content scroll is done on the next frame, nothing is written before that
+#define SSD1306_SCROLL_TIME     15000
+
 // Enumeration for screen colors
 typedef enum {
     Black = 0x00, // Black color, no pixel
@@ -48,14 +57,18 @@ typedef struct {
 void ssd1306_Init(void);
 void ssd1306_Fill(SSD1306_COLOR color);
 void ssd1306_UpdateScreen(void);
+void ssd1306_MarkDirty(int16_t x, int16_t y, int16_t w, int16_t h);
+void ssd1306_UpdateDirty(void);
+void ssd1306_ScrollLeft(uint8_t startPage, uint8_t endPage, uint8_t first,
+		uint8_t last);
+uint8_t ssd1306_ScrollDone(void);
+void ssd1306_WriteColumn(uint8_t x, uint8_t startPage, uint8_t endPage);
+uint8_t* ssd1306_GetBuffer(void);
 void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color);
 char ssd1306_WriteChar(char ch, FontDef Font, SSD1306_COLOR color);
 char ssd1306_WriteString(char* str, FontDef Font, SSD1306_COLOR color);
 void ssd1306_SetCursor(uint8_t x, uint8_t y);
 
-void ssd1306_PrintDateAndTime(char *date, char *time);
-void ssd1306_PrintTemperatures(char *tBoiler, char *tWaterHeater, char *tCollector);
-
 #ifdef __cplusplus
 }
 #endif
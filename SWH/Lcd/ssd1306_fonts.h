@@ -3,10 +3,13 @@
 #ifndef __SSD1306_FONTS_H__
 #define __SSD1306_FONTS_H__
 
+// Fonts are generated by host/fontgen.c, see there for the data format
 typedef struct {
 	const uint8_t FontWidth;    /*!< Font width in pixels */
 	uint8_t FontHeight;   /*!< Font height in pixels */
-	const uint16_t *data; /*!< Pointer to data font data array */
+	const uint8_t *data; /*!< Pointer to data font data array */
+	const char *chars;    /*!< Characters in data, NULL for ' ' to '~' */
+	const uint16_t *offset; /*!< Start of every RLE glyph, NULL if bit-packed */
 } FontDef;
 
 
@@ -0,0 +1,263 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_gfx.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Integer-only drawing primitives for the SSD1306 screenbuffer.
+ *
+ * The screenbuffer is organized in 8 pages of SSD1306_WIDTH bytes, each byte
+ * holding 8 vertical pixels. Rectangles and vertical lines are therefore
+ * written as whole (masked) bytes per page, horizontal lines touch one bit
+ * per column and circles are drawn with the midpoint algorithm, so nothing
+ * in here needs floating point or a per-pixel bounds check.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include "ssd1306_gfx.h"
+
+/** Private functions ------------------------------------------------------- */
+static inline void gfx_SetPixel(uint8_t *buffer, int16_t x, int16_t y,
+		SSD1306_COLOR color) {
+	if ((uint16_t) x >= SSD1306_WIDTH || (uint16_t) y >= SSD1306_HEIGHT) {
+		return;
+	}
+
+	if (color == White) {
+		buffer[x + (y >> 3) * SSD1306_WIDTH] |= 1 << (y & 7);
+	} else {
+		buffer[x + (y >> 3) * SSD1306_WIDTH] &= ~(1 << (y & 7));
+	}
+}
+
+/** Public functions -------------------------------------------------------- */
+// Draw horizontal line of w pixels starting at (x, y)
+void ssd1306_DrawHLine(int16_t x, int16_t y, int16_t w, SSD1306_COLOR color) {
+	uint8_t *ptr;
+	uint8_t mask;
+
+	if ((uint16_t) y >= SSD1306_HEIGHT || w <= 0) {
+		return;
+	}
+	// Clip to the screen
+	if (x < 0) {
+		w += x;
+		x = 0;
+	}
+	if (x + w > SSD1306_WIDTH) {
+		w = SSD1306_WIDTH - x;
+	}
+	if (w <= 0) {
+		return;
+	}
+
+	ptr = &ssd1306_GetBuffer()[x + (y >> 3) * SSD1306_WIDTH];
+	mask = 1 << (y & 7);
+	if (color == White) {
+		while (w--) {
+			*ptr++ |= mask;
+		}
+	} else {
+		mask = ~mask;
+		while (w--) {
+			*ptr++ &= mask;
+		}
+	}
+}
+
+// Draw vertical line of h pixels starting at (x, y)
+void ssd1306_DrawVLine(int16_t x, int16_t y, int16_t h, SSD1306_COLOR color) {
+	ssd1306_FillRect(x, y, 1, h, color);
+}
+
+// Draw line from (x0, y0) to (x1, y1) using Bresenham's algorithm
+void ssd1306_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+		SSD1306_COLOR color) {
+	uint8_t *buffer;
+	int16_t dx, dy, sx, sy, err, e2;
+
+	// Straight lines are much cheaper as spans
+	if (y0 == y1) {
+		if (x1 < x0) {
+			ssd1306_DrawHLine(x1, y0, x0 - x1 + 1, color);
+		} else {
+			ssd1306_DrawHLine(x0, y0, x1 - x0 + 1, color);
+		}
+		return;
+	}
+	if (x0 == x1) {
+		if (y1 < y0) {
+			ssd1306_FillRect(x0, y1, 1, y0 - y1 + 1, color);
+		} else {
+			ssd1306_FillRect(x0, y0, 1, y1 - y0 + 1, color);
+		}
+		return;
+	}
+
+	buffer = ssd1306_GetBuffer();
+	dx = (x1 > x0) ? (x1 - x0) : (x0 - x1);
+	dy = (y1 > y0) ? (y0 - y1) : (y1 - y0);
+	sx = (x0 < x1) ? 1 : -1;
+	sy = (y0 < y1) ? 1 : -1;
+	err = dx + dy;
+
+	for (;;) {
+		gfx_SetPixel(buffer, x0, y0, color);
+		if (x0 == x1 && y0 == y1) {
+			break;
+		}
+		e2 = 2 * err;
+		if (e2 >= dy) {
+			err += dy;
+			x0 += sx;
+		}
+		if (e2 <= dx) {
+			err += dx;
+			y0 += sy;
+		}
+	}
+}
+
+// Draw rectangle outline with top left corner in (x, y)
+void ssd1306_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+		SSD1306_COLOR color) {
+	if (w <= 0 || h <= 0) {
+		return;
+	}
+
+	ssd1306_DrawHLine(x, y, w, color);
+	ssd1306_DrawHLine(x, y + h - 1, w, color);
+	ssd1306_FillRect(x, y, 1, h, color);
+	ssd1306_FillRect(x + w - 1, y, 1, h, color);
+}
+
+// Fill rectangle with top left corner in (x, y), one masked byte per page
+void ssd1306_FillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+		SSD1306_COLOR color) {
+	uint8_t *buffer;
+	uint8_t *ptr;
+	uint8_t mask;
+	int16_t i, y1, page, lastPage;
+
+	// Clip to the screen
+	if (x < 0) {
+		w += x;
+		x = 0;
+	}
+	if (y < 0) {
+		h += y;
+		y = 0;
+	}
+	if (x + w > SSD1306_WIDTH) {
+		w = SSD1306_WIDTH - x;
+	}
+	if (y + h > SSD1306_HEIGHT) {
+		h = SSD1306_HEIGHT - y;
+	}
+	if (w <= 0 || h <= 0) {
+		return;
+	}
+
+	buffer = ssd1306_GetBuffer();
+	y1 = y + h - 1;
+	lastPage = y1 >> 3;
+	for (page = y >> 3; page <= lastPage; page++) {
+		// Bits of this page covered by the rectangle
+		mask = 0xFF;
+		if (page == (y >> 3)) {
+			mask &= 0xFF << (y & 7);
+		}
+		if (page == lastPage) {
+			mask &= 0xFF >> (7 - (y1 & 7));
+		}
+
+		ptr = &buffer[x + page * SSD1306_WIDTH];
+		if (color == White) {
+			for (i = 0; i < w; i++) {
+				*ptr++ |= mask;
+			}
+		} else {
+			mask = ~mask;
+			for (i = 0; i < w; i++) {
+				*ptr++ &= mask;
+			}
+		}
+	}
+}
+
+// Draw circle outline using the midpoint algorithm
+void ssd1306_DrawCircle(int16_t x0, int16_t y0, int16_t radius,
+		SSD1306_COLOR color) {
+	uint8_t *buffer;
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+
+	if (radius < 0) {
+		return;
+	}
+
+	buffer = ssd1306_GetBuffer();
+	gfx_SetPixel(buffer, x0, y0 + radius, color);
+	gfx_SetPixel(buffer, x0, y0 - radius, color);
+	gfx_SetPixel(buffer, x0 + radius, y0, color);
+	gfx_SetPixel(buffer, x0 - radius, y0, color);
+
+	while (x < y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		gfx_SetPixel(buffer, x0 + x, y0 + y, color);
+		gfx_SetPixel(buffer, x0 - x, y0 + y, color);
+		gfx_SetPixel(buffer, x0 + x, y0 - y, color);
+		gfx_SetPixel(buffer, x0 - x, y0 - y, color);
+		gfx_SetPixel(buffer, x0 + y, y0 + x, color);
+		gfx_SetPixel(buffer, x0 - y, y0 + x, color);
+		gfx_SetPixel(buffer, x0 + y, y0 - x, color);
+		gfx_SetPixel(buffer, x0 - y, y0 - x, color);
+	}
+}
+
+// Draw filled circle as horizontal spans, one pair per midpoint step
+void ssd1306_FillCircle(int16_t x0, int16_t y0, int16_t radius,
+		SSD1306_COLOR color) {
+	int16_t f = 1 - radius;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * radius;
+	int16_t x = 0;
+	int16_t y = radius;
+
+	if (radius < 0) {
+		return;
+	}
+
+	ssd1306_DrawHLine(x0 - radius, y0, 2 * radius + 1, color);
+
+	while (x < y) {
+		if (f >= 0) {
+			// Outer spans only change when y steps
+			ssd1306_DrawHLine(x0 - x, y0 + y, 2 * x + 1, color);
+			ssd1306_DrawHLine(x0 - x, y0 - y, 2 * x + 1, color);
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		ssd1306_DrawHLine(x0 - y, y0 + x, 2 * y + 1, color);
+		ssd1306_DrawHLine(x0 - y, y0 - x, 2 * y + 1, color);
+	}
+	// Close the top and bottom caps
+	ssd1306_DrawHLine(x0 - x, y0 + y, 2 * x + 1, color);
+	ssd1306_DrawHLine(x0 - x, y0 - y, 2 * x + 1, color);
+}
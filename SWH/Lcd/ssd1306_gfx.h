@@ -0,0 +1,37 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_gfx.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __SSD1306_GFX_H
+#define __SSD1306_GFX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "ssd1306.h"
+
+/** Public function prototypes ---------------------------------------------- */
+void ssd1306_DrawHLine(int16_t x, int16_t y, int16_t w, SSD1306_COLOR color);
+void ssd1306_DrawVLine(int16_t x, int16_t y, int16_t h, SSD1306_COLOR color);
+void ssd1306_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+		SSD1306_COLOR color);
+void ssd1306_DrawRect(int16_t x, int16_t y, int16_t w, int16_t h,
+		SSD1306_COLOR color);
+void ssd1306_FillRect(int16_t x, int16_t y, int16_t w, int16_t h,
+		SSD1306_COLOR color);
+void ssd1306_DrawCircle(int16_t x0, int16_t y0, int16_t radius,
+		SSD1306_COLOR color);
+void ssd1306_FillCircle(int16_t x0, int16_t y0, int16_t radius,
+		SSD1306_COLOR color);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SSD1306_GFX_H */
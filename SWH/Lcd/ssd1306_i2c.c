@@ -28,6 +28,18 @@ void ssd1306_WriteCommand(uint8_t byte) {
 	i2c_stop(SSD1306_I2Cx);
 }
 
+// Send several bytes to the command register in one transfer
+void ssd1306_WriteCommands(uint8_t* buffer, uint16_t buff_size) {
+	uint16_t i;
+	i2c_start(SSD1306_I2Cx);
+	i2c_address_direction(SSD1306_I2Cx, SSD1306_I2C_ADDR, I2C_Direction_Transmitter);
+	i2c_transmit(SSD1306_I2Cx, 0x00); // Co = 0, all following bytes are commands
+	for (i = 0; i < buff_size; i++) {
+		i2c_transmit(SSD1306_I2Cx, buffer[i]);
+	}
+	i2c_stop(SSD1306_I2Cx);
+}
+
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, uint16_t buff_size) {
 	uint16_t i;
@@ -22,6 +22,7 @@ extern "C" {
 /** Public function prototypes ---------------------------------------------- */
 void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
+void ssd1306_WriteCommands(uint8_t* buffer, uint16_t buff_size);
 void ssd1306_WriteData(uint8_t* buffer, uint16_t buff_size);
 
 #ifdef __cplusplus
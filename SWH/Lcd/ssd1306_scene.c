@@ -0,0 +1,157 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_scene.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Retained-mode scene for the SSD1306 screen.
+ *
+ * A screen is a list of widgets. When a screen is shown every widget is
+ * drawn and the whole screenbuffer is flushed. After that scene_Update()
+ * only asks the bound getters for their values, redraws the widgets whose
+ * value changed and flushes just the pages/columns those widgets cover.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <stddef.h>
+#include "ssd1306_scene.h"
+#include "ssd1306_gfx.h"
+
+/** Private variables ------------------------------------------------------- */
+static Screen_t *CurrentScreen;
+
+/** Private functions ------------------------------------------------------- */
+// Format number into str without sprintf, returns number of chars
+static uint8_t scene_FormatNumber(int16_t value, NumberFormat_t format,
+		char *str) {
+	uint16_t abs;
+
+	if (format == NUMBER_TWO_DIGITS) {
+		if (value == SCENE_NO_VALUE) {
+			str[0] = '-';
+			str[1] = '-';
+		} else {
+			str[0] = (uint16_t) value / 10 % 10 + '0';
+			str[1] = (uint16_t) value % 10 + '0';
+		}
+		str[2] = '\0';
+		return 2;
+	}
+
+	if (format == NUMBER_PERCENT && value != SCENE_NO_VALUE) {
+		abs = (uint16_t) value;
+		str[0] = abs / 100 ? abs / 100 % 10 + '0' : ' ';
+		str[1] = abs / 10 ? abs / 10 % 10 + '0' : ' ';
+		str[2] = abs % 10 + '0';
+		str[3] = '\0';
+		return 3;
+	}
+
+	if (value == SCENE_NO_VALUE) {
+		str[0] = ' ';
+		str[1] = '-';
+		str[2] = '-';
+	} else {
+		// Check if temperature is negative
+		if (value < 0) {
+			str[0] = '-';
+			abs = -value;
+		} else {
+			abs = value;
+			if (abs / 100)
+				str[0] = abs / 100 % 10 + '0';
+			else
+				str[0] = '+';
+		}
+		str[1] = (abs / 10) % 10 + '0'; // Extract tens digit
+		str[2] = abs % 10 + '0'; // Extract ones digit
+	}
+	str[3] = '\0';
+	return 3;
+}
+
+static void scene_DrawWidget(Widget_t *widget) {
+	char str[4];
+	uint8_t len;
+	uint8_t r;
+
+	switch (widget->type) {
+	case WIDGET_LABEL:
+		ssd1306_SetCursor(widget->x, widget->y);
+		ssd1306_WriteString((char *) widget->text, *widget->font, White);
+		break;
+	case WIDGET_NUMBER:
+		len = scene_FormatNumber(widget->value, widget->format, str);
+		ssd1306_SetCursor(widget->x, widget->y);
+		ssd1306_WriteString(str, *widget->font, White);
+		ssd1306_MarkDirty(widget->x, widget->y, len * widget->font->FontWidth,
+				widget->font->FontHeight);
+		break;
+	case WIDGET_INDICATOR:
+		r = widget->radius;
+		ssd1306_FillRect(widget->x - r, widget->y - r, 2 * r + 1, 2 * r + 1,
+				Black);
+		if (widget->value) {
+			ssd1306_FillCircle(widget->x, widget->y, r, White);
+		} else {
+			ssd1306_DrawCircle(widget->x, widget->y, r, White);
+		}
+		ssd1306_MarkDirty(widget->x - r, widget->y - r, 2 * r + 1, 2 * r + 1);
+		break;
+	case WIDGET_TREND:
+		trend_Draw(widget->trend);
+		break;
+	default:
+		break;
+	}
+}
+
+/** Public functions -------------------------------------------------------- */
+// Switch to the given screen, draw all of its widgets and flush everything
+void scene_Show(Screen_t *screen) {
+	uint8_t i;
+	Widget_t *widget;
+
+	CurrentScreen = screen;
+	ssd1306_Fill(Black);
+	for (i = 0; i < screen->count; i++) {
+		widget = &screen->widgets[i];
+		if (widget->getValue != NULL) {
+			widget->value = widget->getValue();
+		}
+		scene_DrawWidget(widget);
+	}
+	ssd1306_UpdateScreen();
+}
+
+// Redraw widgets whose bound value changed and flush only their area
+void scene_Update(void) {
+	uint8_t i;
+	int16_t value;
+	Widget_t *widget;
+
+	if (CurrentScreen == NULL) {
+		return;
+	}
+
+	for (i = 0; i < CurrentScreen->count; i++) {
+		widget = &CurrentScreen->widgets[i];
+		if (widget->type == WIDGET_TREND) {
+			trend_Update(widget->trend);
+			continue;
+		}
+		if (widget->getValue == NULL) {
+			continue;
+		}
+		value = widget->getValue();
+		if (value != widget->value) {
+			widget->value = value;
+			scene_DrawWidget(widget);
+		}
+	}
+	ssd1306_UpdateDirty();
+}
+
+Screen_t *scene_GetCurrent(void) {
+	return CurrentScreen;
+}
@@ -0,0 +1,68 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_scene.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __SSD1306_SCENE_H
+#define __SSD1306_SCENE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "ssd1306.h"
+#include "ssd1306_trend.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Value returned by a getter when there is nothing to show (printed as --)
+#define SCENE_NO_VALUE			((int16_t) 0x8000)
+
+typedef enum {
+	WIDGET_LABEL = 0,	// static text, drawn only when screen is shown
+	WIDGET_NUMBER,		// number bound to a getter
+	WIDGET_INDICATOR,	// circle, filled when bound value is not zero
+	WIDGET_TREND		// trend graph, redrawn when samples are pushed
+} WidgetType_t;
+
+typedef enum {
+	NUMBER_TEMPERATURE = 0,	// 3 chars, sign or hundreds and two digits
+	NUMBER_TWO_DIGITS,		// 2 chars, leading zero
+	NUMBER_PERCENT			// 3 chars, 0 to 100, leading spaces
+} NumberFormat_t;
+
+typedef int16_t pGetValue_t(void);
+
+typedef struct {
+	WidgetType_t type;
+	uint8_t x;
+	uint8_t y;
+	FontDef *font;			// WIDGET_LABEL, WIDGET_NUMBER
+	const char *text;		// WIDGET_LABEL
+	NumberFormat_t format;	// WIDGET_NUMBER
+	uint8_t radius;			// WIDGET_INDICATOR, (x, y) is the center
+	pGetValue_t *getValue;	// WIDGET_NUMBER, WIDGET_INDICATOR
+	Trend_t *trend;			// WIDGET_TREND, placed by the trend itself
+	int16_t value;			// last rendered value
+} Widget_t;
+
+typedef struct {
+	Widget_t *widgets;
+	uint8_t count;
+} Screen_t;
+
+#define SCREEN(widgets)		{ widgets, sizeof(widgets) / sizeof(Widget_t) }
+
+/** Public function prototypes ---------------------------------------------- */
+void scene_Show(Screen_t *screen);
+void scene_Update(void);
+Screen_t *scene_GetCurrent(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SSD1306_SCENE_H */
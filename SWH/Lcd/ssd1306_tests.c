@@ -1,7 +1,10 @@
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
 #include "ssd1306.h"
+#include "ssd1306_gfx.h"
 #include "systemTicks.h"
+#include "debugUsart.h"
 
 uint32_t GetTick() {
 	return (uint32_t)(micros / 1000);
@@ -39,9 +42,10 @@ void ssd1306_TestBorder() {
 void ssd1306_TestFonts() {
 	ssd1306_Fill(Black);
 	ssd1306_SetCursor(2, 0);
-	ssd1306_WriteString("Font 16x26", Font_16x26, White);
+	// Big fonts only have digits and signs
+	ssd1306_WriteString("+1626", Font_16x26, White);
 	ssd1306_SetCursor(2, 26);
-	ssd1306_WriteString("Font 11x18", Font_11x18, White);
+	ssd1306_WriteString("-11:18", Font_11x18, White);
 	ssd1306_SetCursor(2, 26 + 18);
 	ssd1306_WriteString("Font 7x10", Font_7x10, White);
 	ssd1306_UpdateScreen();
@@ -53,10 +57,10 @@ void ssd1306_TestFPS() {
 	uint32_t start = GetTick();
 	uint32_t end = start;
 	int fps = 0;
-	char message[] = "ABCDEFGHIJK";
+	char message[] = "0123456789";
 
 	ssd1306_SetCursor(2, 0);
-	ssd1306_WriteString("Testing...", Font_11x18, Black);
+	ssd1306_WriteString("Testing...", Font_7x10, Black);
 
 	do {
 		ssd1306_SetCursor(2, 18);
@@ -79,7 +83,91 @@ void ssd1306_TestFPS() {
 
 	ssd1306_Fill(White);
 	ssd1306_SetCursor(2, 18);
-	ssd1306_WriteString(buff, Font_11x18, Black);
+	ssd1306_WriteString(buff, Font_7x10, Black);
+	ssd1306_UpdateScreen();
+}
+
+// Reference circles as they were drawn before ssd1306_gfx (per pixel, sqrt)
+static void legacy_DrawCircle(int16_t x0, int16_t y0, int16_t radius) {
+	int16_t x, y;
+	double distance;
+
+	for (x = 0; x <= 2 * radius; x++) {
+		for (y = 0; y <= 2 * radius; y++) {
+			distance = sqrt(
+					(double) (x - radius) * (x - radius)
+							+ (y - radius) * (y - radius));
+			if (distance > radius - 0.5 && distance < radius + 0.5) {
+				ssd1306_DrawPixel(x0 + x - radius, y0 + y - radius, White);
+			}
+		}
+	}
+}
+
+static void legacy_FillCircle(int16_t x0, int16_t y0, int16_t radius) {
+	int16_t x, y;
+
+	for (y = -radius; y <= radius; y++) {
+		for (x = -radius; x <= radius; x++) {
+			if (x * x + y * y <= radius * radius) {
+				ssd1306_DrawPixel(x0 + x, y0 + y, White);
+			}
+		}
+	}
+}
+
+static void legacy_FillRect(int16_t x0, int16_t y0, int16_t w, int16_t h) {
+	int16_t x, y;
+
+	for (y = y0; y < y0 + h; y++) {
+		for (x = x0; x < x0 + w; x++) {
+			ssd1306_DrawPixel(x, y, White);
+		}
+	}
+}
+
+// Print rendering cost in CPU cycles of the old and new primitives
+void ssd1306_TestPrimitives() {
+	uint32_t start, legacy, gfx;
+
+	InitCycleCounter();
+
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	legacy_DrawCircle(16, 48, 10);
+	legacy = CYCLES() - start;
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	ssd1306_DrawCircle(16, 48, 10, White);
+	gfx = CYCLES() - start;
+	debug.printf("DrawCircle r=10 : %7u -> %5u cycles\r\n", legacy, gfx);
+
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	legacy_FillCircle(16, 48, 10);
+	legacy = CYCLES() - start;
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	ssd1306_FillCircle(16, 48, 10, White);
+	gfx = CYCLES() - start;
+	debug.printf("FillCircle r=10 : %7u -> %5u cycles\r\n", legacy, gfx);
+
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	legacy_FillRect(10, 5, 100, 50);
+	legacy = CYCLES() - start;
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	ssd1306_FillRect(10, 5, 100, 50, White);
+	gfx = CYCLES() - start;
+	debug.printf("FillRect 100x50 : %7u -> %5u cycles\r\n", legacy, gfx);
+
+	ssd1306_Fill(Black);
+	start = CYCLES();
+	ssd1306_DrawLine(0, 0, 127, 63, White);
+	gfx = CYCLES() - start;
+	debug.printf("DrawLine 128x64 : %5u cycles\r\n", gfx);
+
 	ssd1306_UpdateScreen();
 }
 
@@ -89,4 +177,6 @@ void ssd1306_TestAll() {
 	_DelayMS(1000);
 	ssd1306_TestBorder();
 	ssd1306_TestFonts();
+	_DelayMS(1000);
+	ssd1306_TestPrimitives();
 }
@@ -0,0 +1,167 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_trend.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Trend graph for the SSD1306 screen.
+ *
+ * Samples are kept in a ring buffer with one slot per column, the newest
+ * sample is plotted in the rightmost column. What a column shows depends only
+ * on its own sample and the one before it, so when a new sample arrives the
+ * graph is shifted one column to the left and only the new column has to be
+ * drawn. With SSD1306_CONTENT_SCROLL the shift is also done by the display
+ * itself and a new sample costs one scroll command and one column write.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include <string.h>
+#include "ssd1306_trend.h"
+#include "defines.h"
+
+/** Private functions ------------------------------------------------------- */
+// Sample pushed age samples ago, NULL if the ring buffer doesn't reach it
+static const int8_t *trend_GetSample(Trend_t *trend, uint8_t age) {
+	if (age >= trend->count) {
+		return NULL;
+	}
+	return &trend->samples[(uint16_t) ((trend->head + trend->width - 1 - age)
+			% trend->width) * trend->series];
+}
+
+// Row of the graph for value, 0 is the top row
+static uint8_t trend_GetRow(Trend_t *trend, int8_t value) {
+	uint8_t height = trend->pages * 8;
+
+	if (value <= trend->min) {
+		return height - 1;
+	}
+	if (value >= trend->max) {
+		return 0;
+	}
+	return height - 1
+			- (uint16_t) (value - trend->min) * (height - 1)
+					/ (trend->max - trend->min);
+}
+
+// Draw one column into the screenbuffer, line from the previous sample
+static void trend_DrawColumn(Trend_t *trend, uint8_t column) {
+	uint8_t *ptr = &ssd1306_GetBuffer()[trend->page * SSD1306_WIDTH + trend->x
+			+ column];
+	const int8_t *sample = trend_GetSample(trend, trend->width - 1 - column);
+	const int8_t *prev = trend_GetSample(trend, trend->width - column);
+	uint8_t i, row, from, to;
+
+	for (i = 0; i < trend->pages; i++) {
+		ptr[i * SSD1306_WIDTH] = 0x00;
+	}
+	if (sample == NULL) {
+		return;
+	}
+
+	for (i = 0; i < trend->series; i++) {
+		if (sample[i] == TREND_NO_SAMPLE) {
+			continue;
+		}
+		from = to = trend_GetRow(trend, sample[i]);
+		if (prev != NULL && prev[i] != TREND_NO_SAMPLE) {
+			row = trend_GetRow(trend, prev[i]);
+			// Vertical step up to the previous value keeps the line closed
+			if (row < from) {
+				from = row + 1;
+			} else if (row > to) {
+				to = row - 1;
+			}
+		}
+		for (row = from; row <= to; row++) {
+			ptr[(row >> 3) * SSD1306_WIDTH] |= 1 << (row & 7);
+		}
+	}
+}
+
+/** Public functions -------------------------------------------------------- */
+// Add sample, values has trend->series elements
+void trend_Push(Trend_t *trend, const int16_t *values) {
+	int8_t *slot = &trend->samples[(uint16_t) trend->head * trend->series];
+	uint8_t i;
+
+	for (i = 0; i < trend->series; i++) {
+		if (values[i] < -127) {
+			slot[i] = TREND_NO_SAMPLE;
+		} else if (values[i] > 127) {
+			slot[i] = 127;
+		} else {
+			slot[i] = values[i];
+		}
+	}
+
+	trend->head++;
+	if (trend->head >= trend->width) {
+		trend->head = 0;
+	}
+	if (trend->count < trend->width) {
+		trend->count++;
+	}
+	if (trend->pending < 0xFF) {
+		trend->pending++;
+	}
+}
+
+// Draw the whole graph into the screenbuffer
+void trend_Draw(Trend_t *trend) {
+	uint8_t column;
+
+	for (column = 0; column < trend->width; column++) {
+		trend_DrawColumn(trend, column);
+	}
+	trend->pending = 0;
+	trend->column = false;
+}
+
+// Bring the graph on the screen up to date with the ring buffer
+void trend_Update(Trend_t *trend) {
+	uint8_t *buffer;
+	uint8_t i;
+
+#if SSD1306_CONTENT_SCROLL
+	// New column of the last sample, once the display RAM has moved
+	if (trend->column && ssd1306_ScrollDone()) {
+		ssd1306_WriteColumn(trend->x + trend->width - 1, trend->page,
+				trend->page + trend->pages - 1);
+		trend->column = false;
+	}
+#endif
+
+	if (trend->pending == 0) {
+		return;
+	}
+
+	if (trend->pending > 1 || trend->column) {
+		// Missed samples while the graph wasn't updated or the column of the
+		// last one isn't out yet, redraw it
+		trend_Draw(trend);
+		ssd1306_MarkDirty(trend->x, trend->page * 8, trend->width,
+				trend->pages * 8);
+		return;
+	}
+
+	// Shift the graph one column to the left and draw the new sample
+	buffer = ssd1306_GetBuffer();
+	for (i = trend->page; i < trend->page + trend->pages; i++) {
+		memmove(&buffer[i * SSD1306_WIDTH + trend->x],
+				&buffer[i * SSD1306_WIDTH + trend->x + 1], trend->width - 1);
+	}
+	trend_DrawColumn(trend, trend->width - 1);
+	trend->pending = 0;
+
+#if SSD1306_CONTENT_SCROLL
+	// Whatever is waiting must be on the screen before the display RAM moves
+	ssd1306_UpdateDirty();
+	ssd1306_ScrollLeft(trend->page, trend->page + trend->pages - 1, trend->x,
+			trend->x + trend->width - 1);
+	trend->column = true;
+#else
+	ssd1306_MarkDirty(trend->x, trend->page * 8, trend->width,
+			trend->pages * 8);
+#endif
+}
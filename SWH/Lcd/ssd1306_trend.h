@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_trend.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __SSD1306_TREND_H
+#define __SSD1306_TREND_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "ssd1306.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Stored for values that can't be plotted, anything below -127 becomes this
+#define TREND_NO_SAMPLE			((int8_t) -128)
+
+typedef struct {
+	uint8_t x;				// first column
+	uint8_t page;			// first page
+	uint8_t width;			// columns, one sample per column
+	uint8_t pages;
+	int8_t min;				// value shown on the bottom line
+	int8_t max;				// value shown on the top line
+	uint8_t series;			// values per sample
+	int8_t *samples;		// ring buffer of width * series values
+	uint8_t head;			// slot for the next sample
+	uint8_t count;			// samples in the ring buffer
+	uint8_t pending;		// samples not on the screen yet
+	uint8_t column;			// new column waits for the content scroll
+} Trend_t;
+
+// Trend graph of `_width` samples with `_series` values, placed at page `_page`
+#define TREND(_buffer, _x, _page, _width, _pages, _min, _max, _series) \
+	{ .x = _x, .page = _page, .width = _width, .pages = _pages, \
+	  .min = _min, .max = _max, .series = _series, .samples = _buffer }
+
+/** Public function prototypes ---------------------------------------------- */
+void trend_Push(Trend_t *trend, const int16_t *values);
+void trend_Draw(Trend_t *trend);
+void trend_Update(Trend_t *trend);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __SSD1306_TREND_H */
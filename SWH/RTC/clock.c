@@ -0,0 +1,189 @@
+/**
+ ******************************************************************************
+ * @file		clock.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Software clock counting seconds since CLOCK_EPOCH_YEAR.
+ *
+ * The clock runs from micros, or from the seconds of the time source when
+ * it has them, and is compared with the time source every syncPeriod
+ * seconds. A source that is ahead moves the clock forward at once, one that
+ * is behind makes the clock stand still until the source catches up, so
+ * timestamps never go back. Only clock_Sync, used after the time is set,
+ * can move the clock back.
+ *
+ * The time source is the DS1307 or the RTC of the STM32, see CLOCK_SOURCE.
+ * Without any source the clock still runs, from 0 at power up.
+ *
+ * Conversions are valid from 2000 to 2099, where every fourth year is a
+ * leap year, same as on the DS1307.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include "clock.h"
+#include "systemTicks.h"
+#include "defines.h"
+
+/** Private variables ------------------------------------------------------- */
+// Days before the first of each month in a year that is not a leap year
+static const uint16_t DaysBeforeMonth[12] = { 0, 31, 59, 90, 120, 151, 181,
+		212, 243, 273, 304, 334 };
+
+static const TimeSource_t *m_source;
+static uint32_t m_seconds;		// current timestamp
+static uint32_t m_secondStart;	// micros when m_seconds was incremented
+static uint32_t m_behind;		// seconds to stand still, source is behind
+static uint16_t m_sinceSync;	// seconds since the source was read
+static uint8_t m_synced;
+
+/** Private functions ------------------------------------------------------- */
+static uint8_t clock_ReadSource(uint32_t *timestamp) {
+	m_sinceSync = 0;
+	if (m_source == NULL) {
+		return false;
+	}
+	return m_source->Read(timestamp);
+}
+
+static void clock_Discipline(void) {
+	uint32_t source;
+
+	if (!clock_ReadSource(&source)) {
+		return;
+	}
+	if (source >= m_seconds) {
+		if (source > m_seconds) {
+			m_seconds = source;
+			m_secondStart = micros;
+		}
+		m_behind = 0;
+	} else {
+		m_behind = m_seconds - source;
+	}
+}
+
+// Seconds passed since the last call
+static uint8_t clock_Elapsed(void) {
+	uint8_t elapsed = 0;
+
+	if (m_source != NULL && m_source->Elapsed != NULL) {
+		return m_source->Elapsed();
+	}
+	while (TIMEOUT(m_secondStart, _ONE_SEC)) {
+		m_secondStart += _ONE_SEC;
+		elapsed++;
+	}
+	return elapsed;
+}
+
+/** Public functions -------------------------------------------------------- */
+uint32_t clock_FromTime(const TimeStruct_t *time) {
+	uint32_t days;
+
+	days = time->year * 365UL + (time->year + 3) / 4
+			+ DaysBeforeMonth[time->month - 1] + time->date - 1;
+	if ((time->year & 3) == 0 && time->month > 2) {
+		days++;
+	}
+	return days * CLOCK_SECONDS_PER_DAY + time->hours_24 * 3600UL
+			+ time->minutes * 60 + time->seconds;
+}
+
+void clock_ToTime(uint32_t timestamp, TimeStruct_t *time) {
+	uint32_t days = timestamp / CLOCK_SECONDS_PER_DAY;
+	uint32_t seconds = timestamp % CLOCK_SECONDS_PER_DAY;
+	uint16_t yearDay, monthStart;
+	uint8_t month, leap;
+
+	time->hours_24 = seconds / 3600;
+	seconds %= 3600;
+	time->minutes = seconds / 60;
+	time->seconds = seconds % 60;
+
+	// Leap year first, every 4 years are 1461 days
+	time->year = days * 4 / 1461;
+	yearDay = days - (time->year * 365UL + (time->year + 3) / 4);
+	leap = (time->year & 3) == 0;
+
+	for (month = 11; month > 0; month--) {
+		monthStart = DaysBeforeMonth[month] + (leap && month >= 2);
+		if (yearDay >= monthStart) {
+			break;
+		}
+	}
+	time->month = month + 1;
+	time->date = yearDay - DaysBeforeMonth[month] - (leap && month >= 2) + 1;
+}
+
+// Pick the time source and take the time from it, I2C2 must be initialized
+void clock_Init(void) {
+#if CLOCK_SOURCE == CLOCK_SOURCE_DS1307
+	m_source = Ds1307Source.Init() ? &Ds1307Source : NULL;
+#elif CLOCK_SOURCE == CLOCK_SOURCE_INTERNAL
+	m_source = InternalRtcSource.Init() ? &InternalRtcSource : NULL;
+#else
+	if (Ds1307Source.Init()) {
+		m_source = &Ds1307Source;
+	} else if (InternalRtcSource.Init()) {
+		m_source = &InternalRtcSource;
+	}
+#endif
+	m_secondStart = micros;
+	clock_Sync();
+}
+
+// NULL if there is no time source
+const TimeSource_t *clock_GetSource(void) {
+	return m_source;
+}
+
+uint32_t clock_Now(void) {
+	return m_seconds;
+}
+
+// Called at least once a second, reads the source until it has a valid time
+void clock_Tick(void) {
+	uint8_t elapsed;
+
+	if (!m_synced) {
+		clock_Sync();
+	}
+
+	for (elapsed = clock_Elapsed(); elapsed > 0; elapsed--) {
+		if (m_behind) {
+			m_behind--;
+		} else {
+			m_seconds++;
+		}
+		m_sinceSync++;
+	}
+
+	if (m_source != NULL && m_sinceSync >= m_source->syncPeriod) {
+		clock_Discipline();
+	}
+}
+
+// Take the time from the source as it is, also when that goes back
+void clock_Sync(void) {
+	uint32_t source;
+
+	if (!clock_ReadSource(&source)) {
+		return;
+	}
+	m_seconds = source;
+	m_secondStart = micros;
+	m_behind = 0;
+	m_synced = true;
+}
+
+void clock_SetTime(const TimeStruct_t *time) {
+	if (m_source == NULL) {
+		m_seconds = clock_FromTime(time);
+		m_secondStart = micros;
+		m_behind = 0;
+		return;
+	}
+	m_source->Write(clock_FromTime(time));
+	clock_Sync();
+}
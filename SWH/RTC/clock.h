@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file		clock.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __CLOCK_H
+#define __CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "ds1307.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Timestamp 0 is 1 January 2000 00:00:00, year 00 of the DS1307
+#define CLOCK_EPOCH_YEAR			2000
+
+#define CLOCK_SECONDS_PER_DAY		86400UL
+
+// Where the time comes from, CLOCK_SOURCE picks one at build time
+#define CLOCK_SOURCE_AUTO			0	// DS1307, internal RTC if it doesn't answer
+#define CLOCK_SOURCE_DS1307			1
+#define CLOCK_SOURCE_INTERNAL		2
+
+#ifndef CLOCK_SOURCE
+#define CLOCK_SOURCE				CLOCK_SOURCE_AUTO
+#endif
+
+typedef struct {
+	const char *name;
+	uint8_t (*Init)(void);					// false if the source isn't there
+	uint8_t (*Read)(uint32_t *timestamp);	// false if it has no valid time
+	void (*Write)(uint32_t timestamp);
+	uint8_t (*Elapsed)(void);				// seconds since the last call, NULL
+											// to count them from micros
+	uint16_t syncPeriod;					// seconds between two reads
+} TimeSource_t;
+
+// Defined in ds1307_mid_level.c and stm32_rtc.c
+extern const TimeSource_t Ds1307Source;
+extern const TimeSource_t InternalRtcSource;
+
+/** Public function prototypes ---------------------------------------------- */
+uint32_t clock_FromTime(const TimeStruct_t *time);
+void clock_ToTime(uint32_t timestamp, TimeStruct_t *time);
+
+void clock_Init(void);
+const TimeSource_t *clock_GetSource(void);
+uint32_t clock_Now(void);
+void clock_Tick(void);
+void clock_Sync(void);
+void clock_SetTime(const TimeStruct_t *time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __CLOCK_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
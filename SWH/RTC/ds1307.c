@@ -8,6 +8,7 @@
 
 /** Includes ---------------------------------------------------------------- */
 #include "ds1307.h"
+#include "i2c.h"
 
 /** Private function prototypes --------------------------------------------- */
 uint8_t bcd2bin(uint8_t bcd);
@@ -370,6 +371,100 @@ void ds1307_set_calendar_date(uint8_t day, uint8_t date, uint8_t month, uint8_t
 	ds1307_set_year(year);
 }
 
+/**
+ ******************************************************************************
+ *	@brief	Read seconds to year registers in one transaction, so the time
+ *			can't roll over between the fields
+ * @param	Pointer to structure for store the time, in hour mode 24
+ * @retval	None
+ ******************************************************************************
+ */
+void ds1307_read_all(TimeStruct_t* time) {
+	uint8_t regs[DS1307_YEAR - DS1307_SECONDS + 1];
+
+	i2c_read_multi_with_reg(DS1307_I2Cx, DS1307_DEVICE_ADDRESS, DS1307_SECONDS,
+			sizeof(regs), regs);
+
+	// Bit 7 of seconds is the clock halt bit
+	time->seconds = bcd2bin(regs[DS1307_SECONDS] & 0x7F);
+	time->minutes = bcd2bin(regs[DS1307_MINUTES]);
+	time->hours_24 = bcd2bin(regs[DS1307_HOURS] & 0x3F);
+	time->date = bcd2bin(regs[DS1307_DATE]);
+	time->month = bcd2bin(regs[DS1307_MONTH]);
+	time->year = bcd2bin(regs[DS1307_YEAR]);
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Write seconds to year registers in one transaction, clock halt bit
+ *			is cleared and hour mode is set to 24
+ * @param	Pointer to structure with the time to be set
+ * @param	Day of week, DS1307_SUNDAY to DS1307_SATURDAY
+ * @retval	None
+ ******************************************************************************
+ */
+void ds1307_write_all(TimeStruct_t* time, uint8_t day) {
+	uint8_t regs[DS1307_YEAR - DS1307_SECONDS + 1];
+
+	regs[DS1307_SECONDS] = bin2bcd(check_min_max(time->seconds, 0, 59));
+	regs[DS1307_MINUTES] = bin2bcd(check_min_max(time->minutes, 0, 59));
+	regs[DS1307_HOURS] = bin2bcd(check_min_max(time->hours_24, 0, 23));
+	regs[DS1307_DAY] = check_min_max(day, 1, 7);
+	regs[DS1307_DATE] = bin2bcd(check_min_max(time->date, 1, 31));
+	regs[DS1307_MONTH] = bin2bcd(check_min_max(time->month, 1, 12));
+	regs[DS1307_YEAR] = bin2bcd(check_min_max(time->year, 0, 99));
+
+	i2c_write_multi_with_reg(DS1307_I2Cx, DS1307_DEVICE_ADDRESS,
+			DS1307_SECONDS, regs, sizeof(regs));
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Check if the DS1307 acknowledges its address, without waiting
+ *			forever when it doesn't
+ * @param	None
+ * @retval	true if the DS1307 answered, false otherwise
+ ******************************************************************************
+ */
+uint8_t ds1307_is_present(void) {
+	return i2c_probe(DS1307_I2Cx, DS1307_DEVICE_ADDRESS << 1);
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Read from the battery backed RAM in one transaction
+ * @param	Offset in the RAM, 0 to DS1307_RAM_SIZE - 1
+ * @param	Pointer to data array byte to store the data
+ * @param	Number of bytes to read
+ * @retval	None
+ ******************************************************************************
+ */
+void ds1307_read_ram(uint8_t offset, uint8_t* data, uint8_t len) {
+	if (offset + len > DS1307_RAM_SIZE) {
+		return;
+	}
+	i2c_read_multi_with_reg(DS1307_I2Cx, DS1307_DEVICE_ADDRESS,
+			DS1307_RAM_START + offset, len, data);
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Write to the battery backed RAM in one transaction, there is no
+ *			write cycle to wait for and no limit on the number of writes
+ * @param	Offset in the RAM, 0 to DS1307_RAM_SIZE - 1
+ * @param	Pointer to data byte array
+ * @param	Number of bytes to write
+ * @retval	None
+ ******************************************************************************
+ */
+void ds1307_write_ram(uint8_t offset, uint8_t* data, uint8_t len) {
+	if (offset + len > DS1307_RAM_SIZE) {
+		return;
+	}
+	i2c_write_multi_with_reg(DS1307_I2Cx, DS1307_DEVICE_ADDRESS,
+			DS1307_RAM_START + offset, data, len);
+}
+
 /** Private functions ------------------------------------------------------- */
 /**
  ******************************************************************************
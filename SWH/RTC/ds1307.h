@@ -32,6 +32,10 @@ extern "C" {
 #define DS1307_MONTH				0x05
 #define DS1307_YEAR					0x06
 
+// Battery backed RAM, 56 bytes after the time registers
+#define DS1307_RAM_START			0x08
+#define DS1307_RAM_SIZE				56
+
 // Bits in hours register
 #define DS1307_HOUR_MODE			6
 #define DS1307_AM_PM				5
@@ -51,6 +55,15 @@ extern "C" {
 #define DS1307_FRIDAY				6
 #define DS1307_SATURDAY				7
 
+typedef struct {
+	uint8_t year;
+	uint8_t month;
+	uint8_t date;
+	uint8_t hours_24;
+	uint8_t minutes;
+	uint8_t seconds;
+} TimeStruct_t;
+
 /** Public function prototypes ---------------------------------------------- */
 uint8_t ds1307_get_seconds(void);
 void ds1307_set_seconds(uint8_t seconds);
@@ -76,6 +89,11 @@ void ds1307_get_time_24(uint8_t* hours, uint8_t* minutes, uint8_t* seconds);
 void ds1307_set_time_24(uint8_t hours, uint8_t minutes, uint8_t seconds);
 void ds1307_get_calendar_date(uint8_t* day, uint8_t* date, uint8_t* month, uint8_t* year);
 void ds1307_set_calendar_date(uint8_t day, uint8_t date, uint8_t month, uint8_t year);
+void ds1307_read_all(TimeStruct_t* time);
+void ds1307_write_all(TimeStruct_t* time, uint8_t day);
+uint8_t ds1307_is_present(void);
+void ds1307_read_ram(uint8_t offset, uint8_t* data, uint8_t len);
+void ds1307_write_ram(uint8_t offset, uint8_t* data, uint8_t len);
 
 #ifdef __cplusplus
 }
@@ -10,22 +10,46 @@
 #include <stdio.h>
 #include "ds1307_mid_level.h"
 #include "ds1307.h"
-#include "ssd1306.h"
+#include "clock.h"
 #include "debugUsart.h"
+#include "defines.h"
 
+SetTimeState_t m_setTimeState;
 TimeStruct_t SetTime;
+// Current time of the software clock, updated once per second by ReadTime
+TimeStruct_t m_time;
 
-/** Public functions -------------------------------------------------------- */
-void DisplayTime(void) {
-	char date[] = "00:00:00";
-	char time[] = "00:00:00";
+/** Private functions ------------------------------------------------------- */
+static uint8_t Ds1307_Read(uint32_t *timestamp) {
+	TimeStruct_t time;
+
+	ds1307_read_all(&time);
+	if (time.month < 1 || time.month > 12 || time.date < 1 || time.date > 31
+			|| time.hours_24 > 23 || time.minutes > 59 || time.seconds > 59
+			|| time.year > 99) {
+		return false;
+	}
+	*timestamp = clock_FromTime(&time);
+	return true;
+}
 
-	sprintf(date, "%02d.%02d.%02d", ds1307_get_date(), ds1307_get_month(),
-			ds1307_get_year());
-	sprintf(time, "%02d:%02d:%02d", ds1307_get_hours_24(), ds1307_get_minutes(),
-			ds1307_get_seconds());
+static void Ds1307_Write(uint32_t timestamp) {
+	TimeStruct_t time;
 
-	ssd1306_PrintDateAndTime(date, time);
+	clock_ToTime(timestamp, &time);
+	// 1 January 2000 was a saturday
+	ds1307_write_all(&time,
+			(timestamp / CLOCK_SECONDS_PER_DAY + DS1307_SATURDAY - 1) % 7 + 1);
+}
+
+/** Public variables -------------------------------------------------------- */
+const TimeSource_t Ds1307Source = { "DS1307", &ds1307_is_present, &Ds1307_Read,
+		&Ds1307_Write, NULL, 600 };
+
+/** Public functions -------------------------------------------------------- */
+void ReadTime(void) {
+	clock_Tick();
+	clock_ToTime(clock_Now(), &m_time);
 }
 
 void PrintTime(TimeStruct_t *time) {
@@ -43,12 +67,7 @@ void PrintSetTime(TimeStruct_t *time) {
 
 void InitSetTime(void) {
 	m_setTimeState = TIME_SET_YEAR;
-	SetTime.year = ds1307_get_year();
-	SetTime.month = ds1307_get_month();
-	SetTime.date = ds1307_get_date();
-	SetTime.hours_24 = ds1307_get_hours_24();
-	SetTime.minutes = ds1307_get_minutes();
-	SetTime.seconds = ds1307_get_seconds();
+	SetTime = m_time;
 
 	PrintSetTime(&SetTime);
 }
@@ -71,13 +90,9 @@ void SetTimeNextStep(void) {
 		m_setTimeState = TIME_SET_SECONDS;
 		break;
 	case TIME_SET_SECONDS:
-		ds1307_set_year(SetTime.year);
-		ds1307_set_month(SetTime.month);
-		ds1307_set_date(SetTime.date);
-		ds1307_set_hours_24(SetTime.hours_24);
-		ds1307_set_minutes(SetTime.minutes);
-		ds1307_set_seconds(SetTime.seconds);
+		clock_SetTime(&SetTime);
 		m_setTimeState = TIME_SET_NONE;
+		ReadTime();
 
 		debug.printf("%d.%02d.%02d. %02d:%02d:%02d               \r\n",
 				SetTime.year + 2000, SetTime.month, SetTime.date,
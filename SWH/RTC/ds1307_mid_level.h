@@ -13,6 +13,9 @@
 extern "C" {
 #endif
 
+/** Includes ---------------------------------------------------------------- */
+#include "ds1307.h"
+
 typedef enum {
 	TIME_SET_NONE = 0,
 	TIME_SET_YEAR,
@@ -23,20 +26,12 @@ typedef enum {
 	TIME_SET_SECONDS
 } SetTimeState_t;
 
-typedef struct {
-	uint8_t year;
-	uint8_t month;
-	uint8_t date;
-	uint8_t hours_24;
-	uint8_t minutes;
-	uint8_t seconds;
-} TimeStruct_t;
-
-SetTimeState_t m_setTimeState;
+extern SetTimeState_t m_setTimeState;
 extern TimeStruct_t SetTime;
+extern TimeStruct_t m_time;
 
-void DisplayTime(void);
 void PrintTime(TimeStruct_t *time);
+void ReadTime(void);
 
 void InitSetTime(void);
 void SetTimeNextStep(void);
@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file		stm32_rtc.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Time source on the RTC of the STM32.
+ *
+ * The RTC runs from the LSE with a 1 Hz prescaler and its counter holds the
+ * timestamp directly, so the time is read with a register read instead of
+ * an I2C transaction. The backup domain keeps the counter running from
+ * VBAT, BKP_DR1 tells if the counter was ever set. The seconds interrupt
+ * counts the seconds the software clock runs from.
+ ******************************************************************************
+ */
+
+/** Includes ---------------------------------------------------------------- */
+#include "stm32f10x_rcc.h"
+#include "stm32f10x_pwr.h"
+#include "stm32f10x_bkp.h"
+#include "stm32f10x_rtc.h"
+#include "misc.h"
+#include "stm32_rtc.h"
+#include "systemTicks.h"
+#include "defines.h"
+
+/** Private variables ------------------------------------------------------- */
+static volatile uint8_t m_rtcSeconds;	// seconds interrupts not counted yet
+static uint8_t m_rtcValid;
+
+/** Public variables -------------------------------------------------------- */
+const TimeSource_t InternalRtcSource = { "STM32 RTC", &stm32_rtc_init,
+		&stm32_rtc_read, &stm32_rtc_write, &stm32_rtc_elapsed, 60 };
+
+/** Public functions -------------------------------------------------------- */
+/**
+ ******************************************************************************
+ *	@brief	Start the RTC, the counter is left running if it was set before
+ * @param	None
+ * @retval	false if the LSE doesn't start, true otherwise
+ ******************************************************************************
+ */
+uint8_t stm32_rtc_init(void) {
+	NVIC_InitTypeDef NVIC_InitStructure;
+	uint32_t start;
+
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_PWR | RCC_APB1Periph_BKP, ENABLE);
+	PWR_BackupAccessCmd(ENABLE);
+
+	m_rtcValid = BKP_ReadBackupRegister(BKP_DR1) == STM32_RTC_MAGIC;
+	if (!m_rtcValid) {
+		// Backup domain lost power, start the LSE and the RTC again
+		BKP_DeInit();
+		RCC_LSEConfig(RCC_LSE_ON);
+		start = micros;
+		while (RCC_GetFlagStatus(RCC_FLAG_LSERDY) == RESET) {
+			if (TIMEOUT(start, STM32_RTC_LSE_TIMEOUT)) {
+				RCC_LSEConfig(RCC_LSE_OFF);
+				return false;
+			}
+		}
+		RCC_RTCCLKConfig(RCC_RTCCLKSource_LSE);
+		RCC_RTCCLKCmd(ENABLE);
+
+		RTC_WaitForSynchro();
+		RTC_WaitForLastTask();
+		RTC_SetPrescaler(STM32_RTC_PRESCALER);
+		RTC_WaitForLastTask();
+	} else {
+		RTC_WaitForSynchro();
+	}
+
+	RTC_ITConfig(RTC_IT_SEC, ENABLE);
+	RTC_WaitForLastTask();
+
+	NVIC_InitStructure.NVIC_IRQChannel = RTC_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	return true;
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Read the counter
+ * @param	Pointer to store seconds since CLOCK_EPOCH_YEAR
+ * @retval	false if the counter was never set, true otherwise
+ ******************************************************************************
+ */
+uint8_t stm32_rtc_read(uint32_t *timestamp) {
+	*timestamp = RTC_GetCounter();
+	return m_rtcValid;
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Set the counter
+ * @param	Seconds since CLOCK_EPOCH_YEAR
+ * @retval	None
+ ******************************************************************************
+ */
+void stm32_rtc_write(uint32_t timestamp) {
+	RTC_WaitForLastTask();
+	RTC_SetCounter(timestamp);
+	RTC_WaitForLastTask();
+
+	BKP_WriteBackupRegister(BKP_DR1, STM32_RTC_MAGIC);
+	m_rtcValid = true;
+}
+
+/**
+ ******************************************************************************
+ *	@brief	Seconds counted by the seconds interrupt since the last call
+ * @param	None
+ * @retval	Number of seconds
+ ******************************************************************************
+ */
+uint8_t stm32_rtc_elapsed(void) {
+	uint8_t elapsed;
+
+	__disable_irq();
+	elapsed = m_rtcSeconds;
+	m_rtcSeconds = 0;
+	__enable_irq();
+
+	return elapsed;
+}
+
+void RTC_IRQHandler(void) {
+	if (RTC_GetITStatus(RTC_IT_SEC) != RESET) {
+		RTC_ClearITPendingBit(RTC_IT_SEC);
+		if (m_rtcSeconds < 0xFF) {
+			m_rtcSeconds++;
+		}
+	}
+}
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
@@ -0,0 +1,42 @@
+/**
+ ******************************************************************************
+ * @file		stm32_rtc.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __STM32_RTC_H
+#define __STM32_RTC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "clock.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Kept in BKP_DR1 while the counter holds a valid time
+#define STM32_RTC_MAGIC				0xC10C
+
+// LSE start up takes up to a couple of seconds
+#define STM32_RTC_LSE_TIMEOUT		TIME(3)
+
+// LSE is 32768 Hz, counter counts seconds
+#define STM32_RTC_PRESCALER			32767
+
+/** Public function prototypes ---------------------------------------------- */
+uint8_t stm32_rtc_init(void);
+uint8_t stm32_rtc_read(uint32_t *timestamp);
+void stm32_rtc_write(uint32_t timestamp);
+uint8_t stm32_rtc_elapsed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __STM32_RTC_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
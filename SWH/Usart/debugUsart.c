@@ -7,6 +7,15 @@
 #include "debugUsart.h"
 #include "ds1307_mid_level.h"
 #include "mainController.h"
+#include "crc16.h"
+#include "record.h"
+#include "rollup.h"
+#include "config.h"
+#include "journal.h"
+#include "eeprom.h"
+#include "nrf24_mid_level.h"
+#include "ssd1306_scene.h"
+#include "ssd1306_tests.h"
 
 #define DEBUG_USART		USART2
 
@@ -99,7 +108,14 @@ void PrintAvailableCommands(void) {
 	debug.printf("\r\n? - Print available commands\r\n\r\n");
 
 	// History
-	debug.printf("r - print history\r\n\r\n");
+	debug.printf("r - print history\r\n");
+	debug.printf("o - print hours and days\r\n");
+	debug.printf("u - write pending changes to EEPROM\r\n");
+	debug.printf("p - dump EEPROM\r\n");
+	debug.printf("e - EEPROM CRC and record benchmark\r\n");
+	debug.printf("m - nRF24 SPI benchmark\r\n");
+	debug.printf("z - display primitives benchmark\r\n");
+	debug.printf("v - print radio nodes\r\n\r\n");
 
 	// Time
 	debug.printf("s - set time\r\n");
@@ -109,6 +125,7 @@ void PrintAvailableCommands(void) {
 	debug.printf(". - increment time\r\n\r\n");
 
 	// Delta
+	debug.printf("l - print configuration\r\n");
 	debug.printf("g - decrease DELTA +\r\n");
 	debug.printf("h - increase DELTA +\r\n");
 	debug.printf("j - decrease DELTA -\r\n");
@@ -117,7 +134,7 @@ void PrintAvailableCommands(void) {
 
 /**
  * Check received byte through USART interface
- * Unused characters: e, u, o, p, j, l, z, m;
+ * Unused characters: ;
  */
 void CheckConsoleRx(void) {
 	switch (DebugRxBuff.LastChar) {
@@ -153,9 +170,40 @@ void CheckConsoleRx(void) {
 	case 'k':
 		IncreaseDeltaMinus();
 		break;
+	case 'l':
+		config_Print();
+		break;
 	case 'r':
 		PrintHistory();
 		break;
+	case 'o':
+		PrintRollups();
+		break;
+	case 'u':
+		journal_Compact();
+		rollup_Save();
+		PrintHistory();
+		break;
+	case 'p':
+		eeprom_Dump();
+		break;
+	case 'e':
+		crc16_Benchmark();
+		record_Benchmark();
+		break;
+	case 'm':
+		nRF24_Benchmark();
+		break;
+	case 'z':
+		ssd1306_TestPrimitives();
+		// benchmark drew over the screen
+		if (scene_GetCurrent() != NULL) {
+			scene_Show(scene_GetCurrent());
+		}
+		break;
+	case 'v':
+		nRF24_PrintNodes();
+		break;
 
 	default:
 		debug.printf("[%03d]Wrong Key\r\n", DebugRxBuff.LastChar);
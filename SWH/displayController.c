@@ -0,0 +1,291 @@
+/**
+ ******************************************************************************
+ * @file    displayController.c
+ * @author  Milan Rakic
+ * @version V1.0.0
+ * @date    19-October-2026
+ * @brief   screens shown on the SSD1306 OLED
+ *
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT 2026 MR</center></h2>
+ ******************************************************************************
+ */
+
+#include <stm32f10x.h>
+
+#include "displayController.h"
+#include "mainController.h"
+#include "ssd1306_scene.h"
+#include "ds1820.h"
+#include "ds1307_mid_level.h"
+#include "nrf24_mid_level.h"
+#include "rollup.h"
+
+/* Bound values --------------------------------------------------------------*/
+static int16_t GetBoilerTemperature(void) {
+	return m_temperature[T_BOILER];
+}
+
+static int16_t GetWaterHeaterTemperature(void) {
+	return m_temperature[T_WATER_HEATER];
+}
+
+static int16_t GetCollectorTemperature(void) {
+	const nrf24Node_t *collector = &nrf24Nodes[NRF24_NODE_COLLECTOR];
+
+	return collector->connected ? collector->temperature[0] : SCENE_NO_VALUE;
+}
+
+static int16_t GetBoilerPump(void) {
+	return m_boilerPump;
+}
+
+static int16_t GetCollectorPump(void) {
+	return m_collectorPump;
+}
+
+static int16_t GetDate(void) {
+	return m_time.date;
+}
+
+static int16_t GetMonth(void) {
+	return m_time.month;
+}
+
+static int16_t GetYear(void) {
+	return m_time.year;
+}
+
+static int16_t GetHours(void) {
+	return m_time.hours_24;
+}
+
+static int16_t GetMinutes(void) {
+	return m_time.minutes;
+}
+
+static int16_t GetSeconds(void) {
+	return m_time.seconds;
+}
+
+// Today, from the open day of the rollups
+static int16_t GetCollectorPumpHours(void) {
+	return rollup_Current(ROLLUP_DAY)->collectorPump / 3600;
+}
+
+static int16_t GetCollectorPumpMinutes(void) {
+	return rollup_Current(ROLLUP_DAY)->collectorPump / 60 % 60;
+}
+
+static int16_t GetBoilerPumpHours(void) {
+	return rollup_Current(ROLLUP_DAY)->boilerPump / 3600;
+}
+
+static int16_t GetBoilerPumpMinutes(void) {
+	return rollup_Current(ROLLUP_DAY)->boilerPump / 60 % 60;
+}
+
+static int16_t GetLinkHours(void) {
+	return rollup_Current(ROLLUP_DAY)->link / 3600;
+}
+
+static int16_t GetLinkMinutes(void) {
+	return rollup_Current(ROLLUP_DAY)->link / 60 % 60;
+}
+
+static int16_t GetTodayMax(uint8_t i) {
+	const rollup_t *today = rollup_Current(ROLLUP_DAY);
+
+	return today->valid & (1 << i) ? today->max[i] : SCENE_NO_VALUE;
+}
+
+static int16_t GetCollectorMax(void) {
+	return GetTodayMax(0);
+}
+
+static int16_t GetBoilerMax(void) {
+	return GetTodayMax(2);
+}
+
+// Radio nodes
+static int16_t GetNodeValue(uint8_t i) {
+	return nrf24Nodes[i].connected ?
+			nrf24Nodes[i].temperature[0] : SCENE_NO_VALUE;
+}
+
+static int16_t GetNodeQuality(uint8_t i) {
+	return nrf24Nodes[i].received ? nrf24Nodes[i].quality : SCENE_NO_VALUE;
+}
+
+#define NODE_GETTERS(_i) \
+	static int16_t GetNode##_i##Value(void) { return GetNodeValue(_i); } \
+	static int16_t GetNode##_i##Quality(void) { return GetNodeQuality(_i); }
+
+NODE_GETTERS(0)
+NODE_GETTERS(1)
+NODE_GETTERS(2)
+NODE_GETTERS(3)
+NODE_GETTERS(4)
+NODE_GETTERS(5)
+
+/* Trend ---------------------------------------------------------------------*/
+#define TREND_SERIES		3
+#define TREND_WIDTH			SSD1306_WIDTH	// one column per sample
+#define TREND_PERIOD		60				// seconds averaged into one sample
+
+static int8_t trendSamples[TREND_WIDTH * TREND_SERIES];
+static Trend_t trend = TREND(trendSamples, 0, 2, TREND_WIDTH, 6, 0, 120,
+		TREND_SERIES);
+
+static int16_t trendSum[TREND_SERIES];
+static uint8_t trendReadings[TREND_SERIES];
+static uint8_t trendSeconds;
+
+// Called every second, pushes the average of the last TREND_PERIOD readings
+static void SampleTrend(void) {
+	int16_t values[TREND_SERIES];
+	uint8_t i;
+
+	values[0] = GetCollectorTemperature();
+	values[1] = GetBoilerTemperature();
+	values[2] = GetWaterHeaterTemperature();
+	for (i = 0; i < TREND_SERIES; i++) {
+		if (values[i] != SCENE_NO_VALUE) {
+			trendSum[i] += values[i];
+			trendReadings[i]++;
+		}
+	}
+
+	trendSeconds++;
+	if (trendSeconds < TREND_PERIOD) {
+		return;
+	}
+	for (i = 0; i < TREND_SERIES; i++) {
+		if (trendReadings[i]) {
+			values[i] = trendSum[i] / trendReadings[i];
+		} else {
+			values[i] = SCENE_NO_VALUE;
+		}
+		trendSum[i] = 0;
+		trendReadings[i] = 0;
+	}
+	trendSeconds = 0;
+	trend_Push(&trend, values);
+}
+
+/* Screens -------------------------------------------------------------------*/
+#define LABEL(_x, _y, _font, _text) \
+	{ .type = WIDGET_LABEL, .x = _x, .y = _y, .font = &_font, .text = _text }
+#define NUMBER(_x, _y, _font, _format, _get) \
+	{ .type = WIDGET_NUMBER, .x = _x, .y = _y, .font = &_font, \
+	  .format = _format, .getValue = _get }
+#define INDICATOR(_x, _y, _r, _get) \
+	{ .type = WIDGET_INDICATOR, .x = _x, .y = _y, .radius = _r, \
+	  .getValue = _get }
+#define GRAPH(_trend) \
+	{ .type = WIDGET_TREND, .trend = &_trend }
+
+static Widget_t timeWidgets[] = {
+	LABEL(18, 0, Font_7x10, "DATUM I VREME"),
+	NUMBER(18, 16, Font_11x18, NUMBER_TWO_DIGITS, GetDate),
+	LABEL(40, 16, Font_11x18, "."),
+	NUMBER(51, 16, Font_11x18, NUMBER_TWO_DIGITS, GetMonth),
+	LABEL(73, 16, Font_11x18, "."),
+	NUMBER(84, 16, Font_11x18, NUMBER_TWO_DIGITS, GetYear),
+	NUMBER(18, 38, Font_11x18, NUMBER_TWO_DIGITS, GetHours),
+	LABEL(40, 38, Font_11x18, ":"),
+	NUMBER(51, 38, Font_11x18, NUMBER_TWO_DIGITS, GetMinutes),
+	LABEL(73, 38, Font_11x18, ":"),
+	NUMBER(84, 38, Font_11x18, NUMBER_TWO_DIGITS, GetSeconds),
+};
+
+static Widget_t temperatureWidgets[] = {
+	// Kotao
+	LABEL(92, 0, Font_7x10, "KOTAO"),
+	NUMBER(92, 16, Font_11x18, NUMBER_TEMPERATURE, GetBoilerTemperature),
+	INDICATOR(108, 48, 10, GetBoilerPump),
+	// Bojler
+	LABEL(44, 0, Font_7x10, "BOJLER"),
+	NUMBER(40, 24, Font_16x26, NUMBER_TEMPERATURE, GetWaterHeaterTemperature),
+	// Kolektor
+	LABEL(2, 0, Font_7x10, "KOLEK"),
+	NUMBER(2, 16, Font_11x18, NUMBER_TEMPERATURE, GetCollectorTemperature),
+	INDICATOR(16, 48, 10, GetCollectorPump),
+};
+
+// Last TREND_WIDTH minutes of collector, boiler and water heater
+static Widget_t trendWidgets[] = {
+	LABEL(0, 0, Font_7x10, "KL"),
+	NUMBER(14, 0, Font_7x10, NUMBER_TEMPERATURE, GetCollectorTemperature),
+	LABEL(43, 0, Font_7x10, "KT"),
+	NUMBER(57, 0, Font_7x10, NUMBER_TEMPERATURE, GetBoilerTemperature),
+	LABEL(86, 0, Font_7x10, "BJ"),
+	NUMBER(100, 0, Font_7x10, NUMBER_TEMPERATURE, GetWaterHeaterTemperature),
+	GRAPH(trend),
+};
+
+// Pump and link time today, highest temperature today
+static Widget_t todayWidgets[] = {
+	LABEL(46, 0, Font_7x10, "DANAS"),
+	LABEL(0, 16, Font_7x10, "KOLEK"),
+	NUMBER(49, 16, Font_7x10, NUMBER_TWO_DIGITS, GetCollectorPumpHours),
+	LABEL(63, 16, Font_7x10, ":"),
+	NUMBER(70, 16, Font_7x10, NUMBER_TWO_DIGITS, GetCollectorPumpMinutes),
+	NUMBER(100, 16, Font_7x10, NUMBER_TEMPERATURE, GetCollectorMax),
+	LABEL(0, 32, Font_7x10, "KOTAO"),
+	NUMBER(49, 32, Font_7x10, NUMBER_TWO_DIGITS, GetBoilerPumpHours),
+	LABEL(63, 32, Font_7x10, ":"),
+	NUMBER(70, 32, Font_7x10, NUMBER_TWO_DIGITS, GetBoilerPumpMinutes),
+	NUMBER(100, 32, Font_7x10, NUMBER_TEMPERATURE, GetBoilerMax),
+	LABEL(0, 48, Font_7x10, "VEZA"),
+	NUMBER(49, 48, Font_7x10, NUMBER_TWO_DIGITS, GetLinkHours),
+	LABEL(63, 48, Font_7x10, ":"),
+	NUMBER(70, 48, Font_7x10, NUMBER_TWO_DIGITS, GetLinkMinutes),
+};
+
+// Last value and link quality of the first six nodes, as many as fit
+#define NODE_ROW(_i, _label) \
+	LABEL(8, _i * 10 + 2, Font_7x10, _label), \
+	NUMBER(44, _i * 10 + 2, Font_7x10, NUMBER_TEMPERATURE, GetNode##_i##Value), \
+	NUMBER(86, _i * 10 + 2, Font_7x10, NUMBER_PERCENT, GetNode##_i##Quality), \
+	LABEL(107, _i * 10 + 2, Font_7x10, "%")
+
+static Widget_t nodesWidgets[] = {
+	NODE_ROW(0, "N0"),
+	NODE_ROW(1, "N1"),
+	NODE_ROW(2, "N2"),
+	NODE_ROW(3, "N3"),
+	NODE_ROW(4, "N4"),
+	NODE_ROW(5, "N5"),
+};
+
+static Screen_t timeScreen = SCREEN(timeWidgets);
+static Screen_t temperatureScreen = SCREEN(temperatureWidgets);
+static Screen_t trendScreen = SCREEN(trendWidgets);
+static Screen_t todayScreen = SCREEN(todayWidgets);
+static Screen_t nodesScreen = SCREEN(nodesWidgets);
+
+/* Public functions ----------------------------------------------------------*/
+uint8_t m_displayCounter;
+
+// Called every second, the whole screen is drawn only when it changes
+void UpdateDisplay(void) {
+	SampleTrend();
+
+	if (m_displayCounter == 0) {
+		scene_Show(&timeScreen);
+	} else if (m_displayCounter == 3) {
+		scene_Show(&temperatureScreen);
+	} else if (m_displayCounter == 6) {
+		scene_Show(&trendScreen);
+	} else if (m_displayCounter == 9) {
+		scene_Show(&todayScreen);
+	} else if (m_displayCounter == 12) {
+		scene_Show(&nodesScreen);
+	} else {
+		scene_Update();
+	}
+	m_displayCounter++;
+	if (m_displayCounter >= 15)
+		m_displayCounter = 0;
+}
@@ -0,0 +1,19 @@
+/**
+ ******************************************************************************
+ * @file    displayController.h
+ * @author  Milan Rakic
+ * @version V1.0.0
+ * @date    19-October-2026
+ * @brief   screens shown on the SSD1306 OLED
+ *
+ ******************************************************************************
+ * <h2><center>&copy; COPYRIGHT 2026 MR</center></h2>
+ ******************************************************************************
+ */
+
+#ifndef __DISPLAYCONTROLLER_H
+#define	__DISPLAYCONTROLLER_H
+
+void UpdateDisplay(void);
+
+#endif	/* __DISPLAYCONTROLLER_H */
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @file		at24c32_sim.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		AT24C32 behaviour model, used in place of the EEPROM on the host.
+ *
+ * Implements the device calls of blockdev.h the way the chip behaves:
+ *  - every transaction takes the bus time of its bits at 100 kHz and moves
+ *    micros forward by it, so code that polls the chip sees time pass
+ *  - a page write wraps inside its page and starts a write cycle, until it
+ *    is over the chip doesn't acknowledge its address
+ *  - the power can be cut after any number of written data bytes, the page
+ *    write it happens in keeps only the bytes before the cut and the chip
+ *    doesn't answer until sim_PowerOn
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "at24c32_sim.h"
+#include "systemTicks.h"
+
+at24c32_sim_t sim;
+
+static const BlockGeometry_t SimGeometry = { "AT24C32 model", SIM_SIZE,
+		SIM_PAGESIZE, 2, 10000 };
+
+/** Private functions ------------------------------------------------------- */
+// Start, bytes with their acknowledge bits and stop on the bus
+static void sim_Bus(uint32_t bytes) {
+	uint32_t time = (bytes * 9 + 2) * SIM_BIT_TIME;
+
+	micros += time;
+	sim.busTime += time;
+}
+
+// Device address on the bus, false if the chip doesn't acknowledge it
+static uint8_t sim_Address(void) {
+	if (sim.busy && micros - sim.busyStart >= sim.writeCycle) {
+		sim.busy = 0;
+	}
+	if (!sim.powered || sim.busy) {
+		sim_Bus(1);
+		sim.nacks++;
+		return 0;
+	}
+	return 1;
+}
+
+static uint8_t sim_Read(uint32_t addr, uint8_t *data, uint16_t len) {
+	if (!sim_Address()) {
+		return 0;
+	}
+	// address write, then the read
+	sim_Bus(3);
+	sim_Bus(1 + len);
+	sim.reads++;
+
+	// the address counter rolls over at the end of the memory
+	while (len--) {
+		*data++ = sim.memory[addr++ % SIM_SIZE];
+	}
+	return 1;
+}
+
+static uint8_t sim_WritePage(uint32_t addr, const uint8_t *data,
+		uint16_t len) {
+	uint32_t page = addr & ~(uint32_t) (SIM_PAGESIZE - 1);
+	uint16_t i;
+
+	if (!sim_Address()) {
+		return 0;
+	}
+
+	for (i = 0; i < len; i++) {
+		if (sim.powerFailAt == 0) {
+			sim.powerFailAt = -1;
+			sim.powered = 0;
+			sim_Bus(3 + i);
+			return 0;
+		}
+		if (sim.powerFailAt > 0) {
+			sim.powerFailAt--;
+		}
+		// the address counter wraps inside the page
+		sim.memory[page + ((addr + i) & (SIM_PAGESIZE - 1))] = data[i];
+	}
+	sim_Bus(3 + len);
+	sim.writes++;
+	sim.bytesWritten += len;
+
+	sim.busy = 1;
+	sim.busyStart = micros;
+	return 1;
+}
+
+// Acknowledge polling, the device address alone
+static uint8_t sim_IsReady(void) {
+	if (!sim_Address()) {
+		return 0;
+	}
+	sim_Bus(1);
+	return 1;
+}
+
+/** Public functions -------------------------------------------------------- */
+const BlockDevice_t At24c32SimDevice = { &SimGeometry, &sim_Read,
+		&sim_WritePage, &sim_IsReady };
+
+// Erased chip with the power on, counters cleared
+void sim_Reset(void) {
+	memset(&sim, 0, sizeof(sim));
+	memset(sim.memory, 0xFF, sizeof(sim.memory));
+	sim.writeCycle = SIM_WRITE_CYCLE;
+	sim.powered = 1;
+	sim.powerFailAt = -1;
+}
+
+// Cut the power after the given number of data bytes is written
+void sim_PowerFailAfter(int32_t bytes) {
+	sim.powerFailAt = bytes;
+}
+
+// Power back on, whatever write cycle was running is over
+void sim_PowerOn(void) {
+	sim.powered = 1;
+	sim.busy = 0;
+	sim.powerFailAt = -1;
+}
@@ -0,0 +1,45 @@
+/**
+ ******************************************************************************
+ * @file		at24c32_sim.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		AT24C32 behaviour model, used in place of the EEPROM on the host.
+ ******************************************************************************
+ */
+
+#ifndef __AT24C32_SIM_H
+#define __AT24C32_SIM_H
+
+#include <stdint.h>
+#include "blockdev.h"
+
+#define SIM_SIZE			0x1000
+#define SIM_PAGESIZE		0x20
+
+// I2C2 runs at 100 kHz
+#define SIM_BIT_TIME		10
+// Typical write cycle, the datasheet allows up to 10 ms
+#define SIM_WRITE_CYCLE		5000
+
+typedef struct {
+	uint8_t memory[SIM_SIZE];
+	uint32_t writeCycle;	// us the chip doesn't answer after a page write
+	uint32_t busyStart;		// micros when the last write cycle started
+	uint8_t busy;
+	uint8_t powered;
+	int32_t powerFailAt;	// data bytes written until the power goes, -1 never
+	uint32_t reads;			// read transactions
+	uint32_t writes;		// page writes, one write cycle each
+	uint32_t bytesWritten;
+	uint32_t nacks;			// addresses not acknowledged, busy or no power
+	uint32_t busTime;		// us the bus was used
+} at24c32_sim_t;
+
+extern at24c32_sim_t sim;
+extern const BlockDevice_t At24c32SimDevice;
+
+void sim_Reset(void);
+void sim_PowerFailAfter(int32_t bytes);
+void sim_PowerOn(void);
+
+#endif	/* __AT24C32_SIM_H */
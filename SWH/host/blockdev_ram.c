@@ -0,0 +1,52 @@
+/**
+ ******************************************************************************
+ * @file		blockdev_ram.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Block device in RAM, used in place of the EEPROM on the host.
+ *
+ * Same geometry as the AT24C32 without the write cycle. A page write wraps
+ * inside its page the way the EEPROM does, so a write blockdev_Write didn't
+ * split correctly shows up as corrupted data. Reads and page writes are
+ * counted.
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "blockdev_ram.h"
+
+blockdev_ram_t ramdev;
+
+static const BlockGeometry_t RamGeometry = { "RAM", RAM_BLOCKDEV_SIZE,
+		RAM_BLOCKDEV_PAGESIZE, 2, 0 };
+
+static uint8_t ramdev_Read(uint32_t addr, uint8_t *data, uint16_t len) {
+	memcpy(data, &ramdev.memory[addr], len);
+	ramdev.reads++;
+	return 1;
+}
+
+static uint8_t ramdev_WritePage(uint32_t addr, const uint8_t *data,
+		uint16_t len) {
+	uint32_t page = addr & ~(uint32_t) (RAM_BLOCKDEV_PAGESIZE - 1);
+	uint16_t i;
+
+	for (i = 0; i < len; i++) {
+		ramdev.memory[page + ((addr + i) & (RAM_BLOCKDEV_PAGESIZE - 1))] =
+				data[i];
+	}
+	ramdev.writes++;
+	ramdev.bytesWritten += len;
+	return 1;
+}
+
+const BlockDevice_t RamBlockDevice = { &RamGeometry, &ramdev_Read,
+		&ramdev_WritePage, NULL };
+
+// Erased EEPROM reads all ones
+void ramdev_Erase(void) {
+	memset(ramdev.memory, 0xFF, sizeof(ramdev.memory));
+	ramdev.reads = 0;
+	ramdev.writes = 0;
+	ramdev.bytesWritten = 0;
+}
@@ -0,0 +1,32 @@
+/**
+ ******************************************************************************
+ * @file		blockdev_ram.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Block device in RAM, used in place of the EEPROM on the host.
+ ******************************************************************************
+ */
+
+#ifndef __BLOCKDEV_RAM_H
+#define __BLOCKDEV_RAM_H
+
+#include <stdint.h>
+#include "blockdev.h"
+
+// Same size and pages as the AT24C32 on the board
+#define RAM_BLOCKDEV_SIZE		0x1000
+#define RAM_BLOCKDEV_PAGESIZE	0x20
+
+typedef struct {
+	uint8_t memory[RAM_BLOCKDEV_SIZE];
+	uint32_t reads;			// Read calls
+	uint32_t writes;		// WritePage calls, one write cycle each
+	uint32_t bytesWritten;
+} blockdev_ram_t;
+
+extern blockdev_ram_t ramdev;
+extern const BlockDevice_t RamBlockDevice;
+
+void ramdev_Erase(void);
+
+#endif	/* __BLOCKDEV_RAM_H */
@@ -0,0 +1,789 @@
+/**
+ ******************************************************************************
+ * @file		eeprom_tool.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Reads, writes and tests EEPROM images on a PC.
+ *
+ * The configuration and history code (config.c, eeprom.c, history.c,
+ * record.c, crc16.c and blockdev.c) is built unchanged for the host, on
+ * the RAM device from blockdev_ram.c or on the AT24C32 model from
+ * at24c32_sim.c. An image is decoded exactly the way the board reads it,
+ * and the storage code can be timed and put through power losses without
+ * a board.
+ *
+ * Build from the SWH directory:
+ *   gcc -std=gnu99 -Ihost -Ihost/stub -I. -IEEPROM -IRTC -Ii2c \
+ *       -DAT24C_PART=AT24C16 \
+ *       -o host/eeprom_tool host/eeprom_tool.c host/blockdev_ram.c \
+ *       host/at24c32_sim.c host/i2c_sim.c EEPROM/config.c EEPROM/eeprom.c \
+ *       EEPROM/history.c EEPROM/record.c EEPROM/crc16.c EEPROM/blockdev.c \
+ *       EEPROM/at24c.c RTC/clock.c
+ *
+ * Usage:
+ *   host/eeprom_tool decode <image>
+ *       configuration entries, hour and day rollups and history records
+ *   host/eeprom_tool csv <image>
+ *       history as CSV, oldest record first
+ *   host/eeprom_tool encode <image> [-p deltaPlus] [-m deltaMinus] [-c csv]
+ *       new image with the deltas and the history from a CSV file in the
+ *       format csv writes
+ *   host/eeprom_tool bench
+ *       time of the storage operations on the AT24C32 model, records the
+ *       log holds and the cost of the record codec
+ *   host/eeprom_tool fuzz [-n runs] [-s seed]
+ *       power loss at random byte offsets while writing, exit code is the
+ *       number of runs that didn't come back with a valid state
+ *   host/eeprom_tool test
+ *       images of older firmware moved over at boot, at24c.c on a 24C16
+ *       model, exit code is the number of checks that failed
+ *
+ * An image is either the raw bytes of the EEPROM or the output of the 'p'
+ * console command, captured from the debug USART.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "blockdev_ram.h"
+#include "at24c32_sim.h"
+#include "i2c_sim.h"
+#include "at24c.h"
+#include "eeprom.h"
+#include "config.h"
+#include "history.h"
+#include "record.h"
+#include "crc16.h"
+#include "debugUsart.h"
+
+// Seconds from 1970 to CLOCK_EPOCH_YEAR
+#define UNIX_EPOCH_OFFSET		946684800UL
+
+#define CSV_HEADER	"timestamp,date,collectorPump,boilerPump,nRFComm," \
+					"tempCollector,tempWaterHeater,tempBoiler\n"
+
+volatile uint32_t micros;
+
+static int Quiet(const char *format, ...) {
+	(void) format;
+	return 0;
+}
+
+// The storage code reports through debug.printf, the tool prints its own
+struct debug_t debug = { Quiet };
+
+// clock.c is linked for the time conversions, there is no time source
+const TimeSource_t Ds1307Source;
+const TimeSource_t InternalRtcSource;
+
+/** Images ------------------------------------------------------------------ */
+// Raw image or the hex dump of eeprom_Dump, into the RAM device
+static int LoadImage(const char *path) {
+	static char text[0x10000];
+	FILE *file;
+	size_t size;
+	char *line, *end;
+	unsigned long addr, value;
+
+	file = fopen(path, "rb");
+	if (file == NULL) {
+		perror(path);
+		return 0;
+	}
+	size = fread(text, 1, sizeof(text) - 1, file);
+	fclose(file);
+
+	ramdev_Erase();
+	blockdev_Init(&RamBlockDevice);
+	if (size == RAM_BLOCKDEV_SIZE) {
+		memcpy(ramdev.memory, text, size);
+		return 1;
+	}
+
+	// "0000: XX XX ..." lines, anything else is skipped
+	text[size] = 0;
+	for (line = strtok(text, "\n"); line; line = strtok(NULL, "\n")) {
+		addr = strtoul(line, &end, 16);
+		if (end == line || *end != ':') {
+			continue;
+		}
+		line = end + 1;
+		while (addr < RAM_BLOCKDEV_SIZE) {
+			value = strtoul(line, &end, 16);
+			if (end == line) {
+				break;
+			}
+			ramdev.memory[addr++] = value;
+			line = end;
+		}
+	}
+	return 1;
+}
+
+static int SaveImage(const char *path) {
+	FILE *file = fopen(path, "wb");
+
+	if (file == NULL) {
+		perror(path);
+		return 0;
+	}
+	fwrite(ramdev.memory, 1, RAM_BLOCKDEV_SIZE, file);
+	fclose(file);
+	return 1;
+}
+
+static void FormatDate(uint32_t timestamp, char *date, size_t size) {
+	time_t seconds = (time_t) timestamp + UNIX_EPOCH_OFFSET;
+
+	strftime(date, size, "%Y-%m-%d %H:%M:%S", gmtime(&seconds));
+}
+
+/** Commands ---------------------------------------------------------------- */
+static void PrintCopy(char name, uint16_t addr) {
+	EEPROM_Array_t copy;
+	uint8_t valid;
+
+	memcpy(&copy, &ramdev.memory[addr], sizeof(copy));
+	valid = copy.Header == EEPROM_HEADER
+			&& copy._CRC
+					== crc16((uint8_t *) &copy, offsetof(EEPROM_Array_t, _CRC));
+	printf("Copy %c at %04X: header %02X sequence %3u DELTA + %3u DELTA - %3u "
+			"CRC %04X %s\n", name, addr, copy.Header, copy.Sequence,
+			copy.Payload.Item.deltaPlus, copy.Payload.Item.deltaMinus,
+			copy._CRC, valid ? "ok" : "bad");
+}
+
+// Records in a block, 0 if the key record isn't valid
+static uint8_t BlockRecords(const uint8_t *block, uint16_t *key,
+		uint8_t *used) {
+	historyData_t data;
+	uint8_t offset, len, count;
+
+	if (!record_DecodeKey(block, key, &data)) {
+		return 0;
+	}
+	offset = RECORD_KEY_SIZE;
+	for (count = 1;; count++) {
+		len = record_Decode(*key, &data, &block[offset],
+				HISTORY_BLOCK_SIZE - offset, &data);
+		if (len == 0) {
+			break;
+		}
+		offset += len;
+	}
+	*used = offset;
+	return count;
+}
+
+// Newest valid entry of every key, like config_Mount reads them
+static void PrintEntries(void) {
+	const configSchema_t *schema;
+	uint8_t key;
+
+	config_Mount();
+	for (key = 0; key < CONFIG_KEYS; key++) {
+		schema = config_Schema(key);
+		printf("%-8s %d (default %d, %d..%d)\n", schema->name,
+				(int) config_Get(key), (int) schema->def, (int) schema->min,
+				(int) schema->max);
+	}
+}
+
+// Rollup slots with a valid CRC, the slot number says which period
+static void PrintRollups(void) {
+	rollup_t rollup;
+	uint16_t slot, i;
+	char date[32];
+
+	for (slot = 0; slot < ROLLUP_HOURS + ROLLUP_DAYS; slot++) {
+		memcpy(&rollup, &ramdev.memory[ROLLUP_START + slot * ROLLUP_SLOT_SIZE],
+				sizeof(rollup));
+		if (rollup.crc != crc16((uint8_t *) &rollup, offsetof(rollup_t, crc))) {
+			continue;
+		}
+		FormatDate(rollup.start, date, sizeof(date));
+		printf("%s %2u: %s %5us, pumps %5us %5us, link %5us",
+				slot < ROLLUP_HOURS ? "Hour" : "Day ",
+				slot < ROLLUP_HOURS ? slot : slot - ROLLUP_HOURS, date,
+				rollup.seconds, rollup.collectorPump, rollup.boilerPump,
+				rollup.link);
+		for (i = 0; i < ROLLUP_TEMPS; i++) {
+			if (rollup.valid & (1 << i)) {
+				printf(", %d/%d/%dC", rollup.min[i], rollup.mean[i],
+						rollup.max[i]);
+			} else {
+				printf(", -");
+			}
+		}
+		printf("\n");
+	}
+}
+
+static int Decode(void) {
+	historyData_t data;
+	uint16_t block, empty = 0, torn = 0, age, key, i;
+	uint8_t *memory, records, used;
+	char date[32];
+
+	PrintCopy('A', EEPROM_SLOT_A);
+	PrintCopy('B', EEPROM_SLOT_B);
+	PrintEntries();
+
+	for (block = 0; block < HISTORY_BLOCKS; block++) {
+		memory = &ramdev.memory[HISTORY_START + block * HISTORY_BLOCK_SIZE];
+		records = BlockRecords(memory, &key, &used);
+		if (records) {
+			printf("Block %3u: key %5u, %2u records, %3u of %u bytes\n",
+					block, key, records, used, HISTORY_BLOCK_SIZE);
+			continue;
+		}
+		for (i = 0; i < RECORD_KEY_SIZE && memory[i] == 0xFF; i++)
+			;
+		if (i == RECORD_KEY_SIZE) {
+			empty++;
+		} else {
+			printf("Block %3u: torn key record\n", block);
+			torn++;
+		}
+	}
+
+	PrintRollups();
+
+	history_Mount();
+	printf("History: %u records in %u blocks, next sequence %u, %u empty, "
+			"%u torn\n", history_Count(), HISTORY_BLOCKS,
+			history_NextSequence(), empty, torn);
+	for (age = history_Count(); age > 0; age--) {
+		if (!history_Get(age - 1, &data)) {
+			continue;
+		}
+		FormatDate(data.timestamp, date, sizeof(date));
+		printf("%5u. %s %3dC, %3dC, %3dC %d, %d, %s\n", history_Count() - age,
+				date, data.tempCollector, data.tempWaterHeater,
+				data.tempBoiler, data.status.bits.collectorPump,
+				data.status.bits.boilerPump,
+				data.status.bits.nRFComm ? "+" : "-");
+	}
+	return 0;
+}
+
+static int Csv(void) {
+	historyData_t data;
+	uint16_t age;
+	char date[32];
+
+	history_Mount();
+	printf(CSV_HEADER);
+	for (age = history_Count(); age > 0; age--) {
+		if (!history_Get(age - 1, &data)) {
+			continue;
+		}
+		FormatDate(data.timestamp, date, sizeof(date));
+		printf("%u,%s,%d,%d,%d,%d,%d,%d\n", data.timestamp, date,
+				data.status.bits.collectorPump, data.status.bits.boilerPump,
+				data.status.bits.nRFComm, data.tempCollector,
+				data.tempWaterHeater, data.tempBoiler);
+	}
+	return 0;
+}
+
+static int Encode(const char *path, int deltaPlus, int deltaMinus,
+		const char *csvPath) {
+	historyData_t data;
+	unsigned int timestamp;
+	int collector, boiler, nrf, tCollector, tWaterHeater, tBoiler;
+	char line[256];
+	FILE *csv;
+
+	ramdev_Erase();
+	blockdev_Init(&RamBlockDevice);
+	config_Mount();
+	if (!config_Set(CONFIG_DELTA_PLUS, deltaPlus)
+			|| !config_Set(CONFIG_DELTA_MINUS, deltaMinus)) {
+		fprintf(stderr, "deltas out of range\n");
+		return 1;
+	}
+	config_Flush();
+	history_Mount();
+
+	if (csvPath != NULL) {
+		csv = fopen(csvPath, "r");
+		if (csv == NULL) {
+			perror(csvPath);
+			return 1;
+		}
+		while (fgets(line, sizeof(line), csv)) {
+			if (sscanf(line, "%u,%*[^,],%d,%d,%d,%d,%d,%d", &timestamp,
+					&collector, &boiler, &nrf, &tCollector, &tWaterHeater,
+					&tBoiler) != 7) {
+				continue;
+			}
+			memset(&data, 0, sizeof(data));
+			data.timestamp = timestamp;
+			data.status.bits.collectorPump = collector;
+			data.status.bits.boilerPump = boiler;
+			data.status.bits.nRFComm = nrf;
+			data.tempCollector = tCollector;
+			data.tempWaterHeater = tWaterHeater;
+			data.tempBoiler = tBoiler;
+			history_Append(&data);
+		}
+		fclose(csv);
+	}
+	printf("%u records\n", history_Count());
+	return !SaveImage(path);
+}
+
+/** Model runs -------------------------------------------------------------- */
+// Records 16 bytes each, before record.c
+#define FIXED_RECORD_SIZE		16
+
+static historyData_t Record(uint32_t timestamp) {
+	historyData_t data;
+
+	memset(&data, 0, sizeof(data));
+	data.timestamp = timestamp;
+	data.tempBoiler = timestamp % 90;
+	data.tempCollector = timestamp % 120;
+	return data;
+}
+
+static void BenchLine(const char *name, uint32_t count, uint32_t start,
+		const at24c32_sim_t *before) {
+	printf("%-16s %5u x %6u us, %4u write cycles, %5u NACKs\n", name, count,
+			(micros - start) / count, sim.writes - before->writes,
+			sim.nacks - before->nacks);
+}
+
+// Pump events minutes apart with the temperatures a few degrees from the
+// event before, until the log is full and wrapped a few times
+static int Capacity(void) {
+	historyData_t data, previous, decoded;
+	uint8_t buffer[RECORD_MAX_SIZE], len = 0;
+	uint32_t i, bytes = 0;
+	clock_t start;
+
+	ramdev_Erase();
+	blockdev_Init(&RamBlockDevice);
+	history_Mount();
+	srand(1);
+	memset(&data, 0, sizeof(data));
+	data.timestamp = 846000000;
+	data.tempCollector = 60;
+	data.tempWaterHeater = 45;
+	data.tempBoiler = 55;
+	for (i = 0; i < 5000; i++) {
+		previous = data;
+		data.timestamp += 60 + rand() % 1800;
+		data.status.B = rand() & RECORD_STATUS_MASK;
+		data.tempCollector += rand() % 9 - 4;
+		data.tempWaterHeater += rand() % 5 - 2;
+		data.tempBoiler += rand() % 7 - 3;
+		if (rand() % 50 == 0) {
+			// collector cooling down over night
+			data.tempCollector -= 30;
+		}
+		history_Append(&data);
+		bytes += record_Encode(0, &previous, &data, buffer);
+	}
+	printf("Capacity: %u records of %u.%u bytes average, %u with %u byte "
+			"records\n", history_Count(), bytes / i, bytes * 10 / i % 10,
+			(uint32_t) (HISTORY_END - HISTORY_START) / FIXED_RECORD_SIZE,
+			FIXED_RECORD_SIZE);
+
+	start = clock();
+	for (i = 0; i < 1000000; i++) {
+		data.tempCollector += i & 1 ? 3 : -3;
+		len += record_Encode(i, &previous, &data, buffer);
+	}
+	printf("record_Encode    %5u ns\n",
+			(uint32_t) ((clock() - start) * 1000 / CLOCKS_PER_SEC));
+	len = record_Encode(0x1234, &previous, &data, buffer);
+	start = clock();
+	for (i = 0; i < 1000000; i++) {
+		if (record_Decode(0x1234, &previous, buffer, len, &decoded) != len) {
+			printf("record_Decode failed\n");
+			return 1;
+		}
+	}
+	printf("record_Decode    %5u ns\n",
+			(uint32_t) ((clock() - start) * 1000 / CLOCKS_PER_SEC));
+	return 0;
+}
+
+// Everything the board does with the EEPROM, timed on the model
+static int Bench(void) {
+	at24c32_sim_t before;
+	historyData_t data;
+	uint32_t start, i;
+
+	sim_Reset();
+	blockdev_Init(&At24c32SimDevice);
+	config_Mount();
+	history_Mount();
+
+	before = sim;
+	start = micros;
+	for (i = 0; i < 100; i++) {
+		config_Set(CONFIG_DELTA_PLUS, 1 + i % 10);
+		config_Flush();
+	}
+	BenchLine("config_Set", 100, start, &before);
+
+	before = sim;
+	start = micros;
+	for (i = 0; i < 1000; i++) {
+		data = Record(i);
+		history_Append(&data);
+	}
+	blockdev_WriteWait();
+	BenchLine("history_Append", 1000, start, &before);
+
+	before = sim;
+	start = micros;
+	config_Mount();
+	BenchLine("config_Mount", 1, start, &before);
+
+	before = sim;
+	start = micros;
+	for (i = 0; i < 1000; i++) {
+		config_Get(CONFIG_DELTA_PLUS);
+	}
+	BenchLine("config_Get", 1000, start, &before);
+
+	before = sim;
+	start = micros;
+	history_Mount();
+	BenchLine("history_Mount", 1, start, &before);
+
+	before = sim;
+	start = micros;
+	for (i = 0; i < history_Count(); i++) {
+		history_Get(i, &data);
+	}
+	BenchLine("history_Get", history_Count(), start, &before);
+	return Capacity();
+}
+
+// Configuration and history written while the power is cut at a random
+// byte, after power on both have to be what was written last or what was
+// being written
+static int FuzzRun(uint32_t cut) {
+	historyData_t data;
+	uint8_t committedPlus = 3, pendingPlus = 3;
+	uint32_t committedTime = 19, pendingTime = 19, i, last;
+	int op;
+
+	sim_Reset();
+	blockdev_Init(&At24c32SimDevice);
+	config_Mount();
+	config_Set(CONFIG_DELTA_PLUS, 3);
+	config_Set(CONFIG_DELTA_MINUS, 1);
+	config_Flush();
+	history_Mount();
+	for (i = 0; i <= committedTime; i++) {
+		data = Record(i);
+		history_Append(&data);
+	}
+
+	sim_PowerFailAfter(cut);
+	for (op = 0; sim.powered; op++) {
+		if (op % 3 == 0) {
+			pendingPlus = 4 + op % 7;
+			config_Set(CONFIG_DELTA_PLUS, pendingPlus);
+			if (config_Flush()) {
+				committedPlus = pendingPlus;
+			}
+		} else {
+			pendingTime = committedTime + 1;
+			data = Record(pendingTime);
+			// in the EEPROM once the pages after the first are written too
+			if (history_Append(&data) && blockdev_WriteWait()) {
+				committedTime = pendingTime;
+			}
+		}
+	}
+
+	sim_PowerOn();
+	blockdev_Init(&At24c32SimDevice);
+	config_Mount();
+	if (config_Get(CONFIG_VERSION) != CONFIG_SCHEMA_VERSION
+			|| config_Get(CONFIG_DELTA_MINUS) != 1
+			|| (config_Get(CONFIG_DELTA_PLUS) != committedPlus
+					&& config_Get(CONFIG_DELTA_PLUS) != pendingPlus)) {
+		printf("cut %u: configuration lost\n", cut);
+		return 1;
+	}
+
+	history_Mount();
+	if (!history_Get(0, &data)
+			|| (data.timestamp != committedTime
+					&& data.timestamp != pendingTime)) {
+		printf("cut %u: newest record lost\n", cut);
+		return 1;
+	}
+	last = data.timestamp;
+	for (i = 1; i < history_Count(); i++) {
+		if (!history_Get(i, &data) || data.timestamp != last - 1) {
+			printf("cut %u: record %u of %u wrong\n", cut, i,
+					history_Count());
+			return 1;
+		}
+		last = data.timestamp;
+	}
+
+	// Log goes on after the torn record
+	data = Record(committedTime + 100);
+	history_Append(&data);
+	history_Mount();
+	if (!history_Get(0, &data) || data.timestamp != committedTime + 100) {
+		printf("cut %u: append after power loss lost\n", cut);
+		return 1;
+	}
+	return 0;
+}
+
+static int Fuzz(int runs, unsigned int seed) {
+	int run, failed = 0;
+
+	srand(seed);
+	for (run = 0; run < runs; run++) {
+		// a few hundred records, the log wraps in some runs
+		failed += FuzzRun(rand() % (SIM_SIZE + SIM_SIZE / 2));
+	}
+	printf("%d runs, %d failed\n", runs, failed);
+	return failed;
+}
+
+/** Tests ------------------------------------------------------------------- */
+static int failed;
+
+static void Check(const char *name, int ok) {
+	if (!ok) {
+		printf("  %s: failed\n", name);
+		failed++;
+	}
+}
+
+// Time of the record age records before the newest one in a legacy image
+static uint32_t LegacyTime(uint8_t count, uint8_t age) {
+	TimeStruct_t time = { 26, 10, 19, 0, 30, 0 };
+
+	time.hours_24 = count - 1 - age;
+	return clock_FromTime(&time);
+}
+
+// Image of the first firmware, count records in the ring with the newest
+// at index, the XOR broken if bad
+static void LegacyImage(uint8_t count, uint8_t index, uint8_t deltaPlus,
+		uint8_t deltaMinus, uint8_t bad) {
+	uint8_t *record, xor = 0;
+	uint16_t i;
+
+	ramdev_Erase();
+	blockdev_Init(&RamBlockDevice);
+	memset(ramdev.memory, 0, EEPROM_LEGACY_SIZE);
+	ramdev.memory[0] = EEPROM_LEGACY_HEADER;
+	for (i = 0; i < count; i++) {
+		record = &ramdev.memory[1 + (index + EEPROM_LEGACY_HISTORIES - i)
+				% EEPROM_LEGACY_HISTORIES * EEPROM_LEGACY_RECORD_SIZE];
+		record[0] = 26;
+		record[1] = 10;
+		record[2] = 19;
+		record[3] = count - 1 - i;
+		record[4] = 30;
+		record[6] = i & RECORD_STATUS_MASK;
+		record[8] = (uint8_t) -5;		// boiler, -5 little endian
+		record[9] = 0xFF;
+		record[10] = 45;
+		record[12] = 60 + i;
+	}
+	ramdev.memory[EEPROM_LEGACY_INDEX] = index;
+	ramdev.memory[EEPROM_LEGACY_INDEX + 1] = deltaPlus;
+	ramdev.memory[EEPROM_LEGACY_INDEX + 2] = deltaMinus;
+	for (i = 0; i < EEPROM_LEGACY_SIZE - 1; i++) {
+		xor ^= ramdev.memory[i];
+	}
+	ramdev.memory[EEPROM_LEGACY_SIZE - 1] = xor ^ bad;
+}
+
+// Deltas and history after the first boot on a legacy image
+static void LegacyCheck(const char *name, uint8_t count, uint8_t deltaPlus,
+		uint8_t deltaMinus) {
+	historyData_t data;
+	uint8_t age, ok = 1;
+
+	config_Mount();
+	history_Mount();
+	for (age = 0; age < count; age++) {
+		ok = ok && history_Get(age, &data)
+				&& data.timestamp == LegacyTime(count, age)
+				&& data.status.B == (age & RECORD_STATUS_MASK)
+				&& data.tempBoiler == -5 && data.tempWaterHeater == 45
+				&& data.tempCollector == 60 + age;
+	}
+	Check(name, ok && history_Count() == count
+			&& config_Get(CONFIG_VERSION) == CONFIG_SCHEMA_VERSION
+			&& config_Get(CONFIG_DELTA_PLUS) == deltaPlus
+			&& config_Get(CONFIG_DELTA_MINUS) == deltaMinus);
+}
+
+// at24c.c on the I2C model of a 24C16, every byte has to land at its
+// address, the block bits of the address in the device address
+static void At24c16(void) {
+	static uint8_t pattern[I2C_SIM_SIZE], data[I2C_SIM_SIZE];
+	uint16_t i;
+
+	i2csim_Reset();
+	blockdev_Init(&At24cDevice);
+	Check("24C16 geometry", blockdev_Size() == I2C_SIM_SIZE
+			&& blockdev_Geometry()->pageSize == I2C_SIM_PAGESIZE
+			&& blockdev_Geometry()->addressBytes == 1);
+
+	for (i = 0; i < I2C_SIM_SIZE; i++) {
+		pattern[i] = i ^ i >> 8;
+	}
+	Check("24C16 write", blockdev_Write(0, pattern, I2C_SIM_SIZE, 1)
+			&& memcmp(i2csim.memory, pattern, I2C_SIM_SIZE) == 0
+			&& i2csim.blocks == 0xFF && i2csim.nacks == 0);
+
+	// across the blocks, starting inside a page
+	memset(data, 0, sizeof(data));
+	Check("24C16 read", blockdev_Read(0x0F3, data, 0x612)
+			&& memcmp(data, &pattern[0x0F3], 0x612) == 0);
+}
+
+// history_Append on the AT24C32 model the way journal_Task calls it, only
+// when the device is ready, never waits for a write cycle
+static void Background(void) {
+	historyData_t data;
+	uint32_t start, longest = 0, i;
+
+	sim_Reset();
+	blockdev_Init(&At24c32SimDevice);
+	config_Mount();
+	history_Mount();
+	for (i = 0; i < 300; i++) {
+		while (!blockdev_IsReady()) {
+			micros += 100;
+		}
+		data = Record(i);
+		start = micros;
+		if (!history_Append(&data)) {
+			break;
+		}
+		if (micros - start > longest) {
+			longest = micros - start;
+		}
+	}
+	Check("history_Append in the background",
+			i == 300 && longest < sim.writeCycle);
+
+	blockdev_WriteWait();
+	history_Mount();
+	Check("history_Append in the background, mounted",
+			history_Get(0, &data) && data.timestamp == 299);
+}
+
+static int Test(void) {
+	// Full ring wrapped, the newest record in the middle
+	LegacyImage(EEPROM_LEGACY_HISTORIES, 3, 5, 2, 0);
+	LegacyCheck("legacy image", EEPROM_LEGACY_HISTORIES, 5, 2);
+	// Moved over once, a second boot doesn't add the records again
+	LegacyCheck("legacy image again", EEPROM_LEGACY_HISTORIES, 5, 2);
+
+	// Ring not full yet, first record went to index 1
+	LegacyImage(4, 4, 7, 0, 0);
+	LegacyCheck("legacy image part full", 4, 7, 0);
+
+	// Deltas out of range keep the defaults, the records still come
+	LegacyImage(2, 2, 0, 20, 0);
+	LegacyCheck("legacy deltas out of range", 2,
+			config_Schema(CONFIG_DELTA_PLUS)->def,
+			config_Schema(CONFIG_DELTA_MINUS)->def);
+
+	// Bad checksum, nothing is taken
+	LegacyImage(EEPROM_LEGACY_HISTORIES, 3, 5, 2, 0x10);
+	LegacyCheck("legacy bad checksum", 0,
+			config_Schema(CONFIG_DELTA_PLUS)->def,
+			config_Schema(CONFIG_DELTA_MINUS)->def);
+
+	At24c16();
+	Background();
+
+	printf("%d failed\n", failed);
+	return failed;
+}
+
+/** Main -------------------------------------------------------------------- */
+static int Usage(void) {
+	fprintf(stderr, "usage: eeprom_tool decode|csv <image>\n"
+			"       eeprom_tool encode <image> [-p deltaPlus] [-m deltaMinus]"
+			" [-c csv]\n"
+			"       eeprom_tool bench\n"
+			"       eeprom_tool fuzz [-n runs] [-s seed]\n"
+			"       eeprom_tool test\n");
+	return 2;
+}
+
+int main(int argc, char **argv) {
+	const char *command, *csvPath = NULL;
+	int deltaPlus = 3, deltaMinus = 1, runs = 1000, opt;
+	unsigned int seed = 1;
+
+	if (argc < 2) {
+		return Usage();
+	}
+	command = argv[1];
+	optind = 2;
+	while ((opt = getopt(argc, argv, "p:m:c:n:s:")) != -1) {
+		switch (opt) {
+		case 'p':
+			deltaPlus = atoi(optarg);
+			break;
+		case 'm':
+			deltaMinus = atoi(optarg);
+			break;
+		case 'c':
+			csvPath = optarg;
+			break;
+		case 'n':
+			runs = atoi(optarg);
+			break;
+		case 's':
+			seed = strtoul(optarg, NULL, 0);
+			break;
+		default:
+			return Usage();
+		}
+	}
+
+	if (strcmp(command, "bench") == 0) {
+		return Bench();
+	}
+	if (strcmp(command, "fuzz") == 0) {
+		return Fuzz(runs, seed);
+	}
+	if (strcmp(command, "test") == 0) {
+		return Test();
+	}
+	if (optind >= argc) {
+		return Usage();
+	}
+	if (strcmp(command, "encode") == 0) {
+		return Encode(argv[optind], deltaPlus, deltaMinus, csvPath);
+	}
+	if (!LoadImage(argv[optind])) {
+		return 1;
+	}
+	if (strcmp(command, "decode") == 0) {
+		return Decode();
+	}
+	if (strcmp(command, "csv") == 0) {
+		return Csv();
+	}
+	return Usage();
+}
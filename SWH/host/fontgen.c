@@ -0,0 +1,262 @@
+/**
+ ******************************************************************************
+ * @file		fontgen.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Generates Lcd/ssd1306_fonts.c from the tables in font_tables.c.
+ *
+ * Every font is cut down to the characters listed in Fonts[] and stored in
+ * whichever of the two formats is smaller:
+ *  - bit-packed: W * H bits per glyph, row by row, MSB first, every glyph
+ *    starts on a byte boundary so glyph n is at n * ((W * H + 7) / 8)
+ *  - RLE: runs of pixels in nibbles (high nibble first), starting with a
+ *    run of background pixels and alternating, a run longer than 15 is
+ *    split with a zero run of the other color. Glyphs start on a byte
+ *    boundary and a uint16_t offset table points to each of them.
+ * The flash used by every font, before and after, is printed and also put
+ * in the header of the generated file.
+ *
+ * Build and run from the SWH directory:
+ *   gcc -std=gnu99 -o host/fontgen host/fontgen.c && host/fontgen
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include "font_tables.c"
+
+#define FIRST_CHAR		' '
+#define LAST_CHAR		'~'
+#define MAX_DATA		8192
+
+typedef struct {
+	const char *name;		// FontDef in the generated file
+	const char *table;		// data array in the generated file
+	const uint16_t *source;
+	uint8_t width;
+	uint8_t height;
+	const char *chars;		// NULL for all from FIRST_CHAR to LAST_CHAR
+} FontSpec_t;
+
+// Characters the firmware prints with each font
+static const FontSpec_t Fonts[] = {
+	{ "Font_7x10", "Font7x10", Font7x10, 7, 10, NULL },
+	{ "Font_11x18", "Font11x18", Font11x18, 11, 18, " +-.0123456789:" },
+	{ "Font_16x26", "Font16x26", Font16x26, 16, 26, " +-0123456789" },
+};
+
+typedef struct {
+	uint8_t data[MAX_DATA];
+	uint16_t size;
+	uint16_t glyphStart[LAST_CHAR - FIRST_CHAR + 2];
+	uint8_t nibble;			// RLE: low nibble of last byte is free
+} Encoded_t;
+
+static Encoded_t Packed, Rle;
+
+static uint8_t GetPixel(const FontSpec_t *font, char ch, uint8_t x, uint8_t y) {
+	return (font->source[(ch - FIRST_CHAR) * font->height + y] << x) & 0x8000 ?
+			1 : 0;
+}
+
+static void PackGlyph(const FontSpec_t *font, char ch) {
+	uint8_t x, y;
+	uint16_t bit = 0;
+	uint16_t start = Packed.size;
+
+	memset(&Packed.data[start], 0, (font->width * font->height + 7) / 8);
+	for (y = 0; y < font->height; y++) {
+		for (x = 0; x < font->width; x++, bit++) {
+			if (GetPixel(font, ch, x, y)) {
+				Packed.data[start + bit / 8] |= 0x80 >> (bit % 8);
+			}
+		}
+	}
+	Packed.size += (font->width * font->height + 7) / 8;
+}
+
+static void PutNibble(uint8_t value) {
+	if (Rle.nibble) {
+		Rle.data[Rle.size - 1] |= value;
+		Rle.nibble = 0;
+	} else {
+		Rle.data[Rle.size++] = value << 4;
+		Rle.nibble = 1;
+	}
+}
+
+static void PutRun(uint16_t run) {
+	while (run > 15) {
+		PutNibble(15);
+		PutNibble(0);
+		run -= 15;
+	}
+	PutNibble(run);
+}
+
+static void RleGlyph(const FontSpec_t *font, char ch) {
+	uint8_t x, y, color = 0;
+	uint16_t run = 0;
+
+	Rle.nibble = 0;
+	for (y = 0; y < font->height; y++) {
+		for (x = 0; x < font->width; x++) {
+			if (GetPixel(font, ch, x, y) == color) {
+				run++;
+			} else {
+				PutRun(run);
+				color = !color;
+				run = 1;
+			}
+		}
+	}
+	PutRun(run);
+}
+
+// Both formats of the given characters
+static void Encode(const FontSpec_t *font, const char *chars, uint8_t count) {
+	uint8_t i;
+
+	Packed.size = 0;
+	Rle.size = 0;
+	for (i = 0; i < count; i++) {
+		Packed.glyphStart[i] = Packed.size;
+		Rle.glyphStart[i] = Rle.size;
+		PackGlyph(font, chars[i]);
+		RleGlyph(font, chars[i]);
+	}
+	Packed.glyphStart[count] = Packed.size;
+	Rle.glyphStart[count] = Rle.size;
+}
+
+static void PrintChar(FILE *f, char ch) {
+	if (ch == ' ') {
+		fprintf(f, "sp");
+	} else if (ch == '\\') {
+		// Backslash would continue the comment on the next line
+		fprintf(f, "backslash");
+	} else {
+		fputc(ch, f);
+	}
+}
+
+static void PrintData(FILE *f, const FontSpec_t *font, const Encoded_t *enc,
+		const char *chars, uint8_t count) {
+	uint8_t i;
+	uint16_t j;
+
+	fprintf(f, "static const uint8_t %s[] = {\n", font->table);
+	for (i = 0; i < count; i++) {
+		for (j = enc->glyphStart[i]; j < enc->glyphStart[i + 1]; j++) {
+			fprintf(f, "0x%02X,", enc->data[j]);
+		}
+		fprintf(f, "  // ");
+		PrintChar(f, chars[i]);
+		fprintf(f, "\n");
+	}
+	fprintf(f, "};\n\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *path = "Lcd/ssd1306_fonts.c";
+	char all[LAST_CHAR - FIRST_CHAR + 2];
+	char report[1024];
+	int used = 0;
+	const FontSpec_t *font;
+	const char *chars;
+	uint8_t i, f, count;
+	uint16_t was, packedSize, rleSize, totalWas = 0, totalNow = 0;
+	uint8_t useRle[sizeof(Fonts) / sizeof(Fonts[0])];
+	FILE *out;
+
+	if (argc > 1) {
+		path = argv[1];
+	}
+	for (i = 0; i <= LAST_CHAR - FIRST_CHAR; i++) {
+		all[i] = FIRST_CHAR + i;
+	}
+	all[i] = '\0';
+
+	used += snprintf(&report[used], sizeof(report) - used,
+			" * Font        Glyphs  Format      Bytes    Was  Saved\n");
+	for (f = 0; f < sizeof(Fonts) / sizeof(Fonts[0]); f++) {
+		font = &Fonts[f];
+		chars = font->chars ? font->chars : all;
+		count = strlen(chars);
+
+		Encode(font, chars, count);
+
+		was = (LAST_CHAR - FIRST_CHAR + 1) * font->height * sizeof(uint16_t);
+		// Subset string is in flash too
+		packedSize = Packed.size + (font->chars ? count + 1 : 0);
+		rleSize = packedSize - Packed.size + Rle.size + count * sizeof(uint16_t);
+		useRle[f] = rleSize < packedSize;
+		totalWas += was;
+		totalNow += useRle[f] ? rleSize : packedSize;
+		used += snprintf(&report[used], sizeof(report) - used,
+				" * %-11s %6u  %-10s %6u %6u %6u\n", font->name, count,
+				useRle[f] ? "RLE" : "bit-packed",
+				useRle[f] ? rleSize : packedSize, was,
+				was - (useRle[f] ? rleSize : packedSize));
+	}
+	used += snprintf(&report[used], sizeof(report) - used,
+			" * %-11s %6s  %-10s %6u %6u %6u\n", "Total", "", "", totalNow,
+			totalWas, totalWas - totalNow);
+
+	out = fopen(path, "w");
+	if (out == NULL) {
+		perror(path);
+		return 1;
+	}
+	fprintf(out, "/**\n"
+			" ******************************************************************************\n"
+			" * @file\t\tssd1306_fonts.c\n"
+			" * @author\t\tMilan Rakic\n"
+			" * @date\t\t19 October 2026\n"
+			" * @brief\t\tGenerated by host/fontgen.c from host/font_tables.c, don't edit.\n"
+			" *\n"
+			"%s"
+			" ******************************************************************************\n"
+			" */\n\n"
+			"#include <stddef.h>\n"
+			"#include \"ssd1306_fonts.h\"\n\n", report);
+
+	for (f = 0; f < sizeof(Fonts) / sizeof(Fonts[0]); f++) {
+		font = &Fonts[f];
+		chars = font->chars ? font->chars : all;
+		count = strlen(chars);
+
+		// Encode again, the buffers hold the last font only
+		Encode(font, chars, count);
+
+		PrintData(out, font, useRle[f] ? &Rle : &Packed, chars, count);
+		if (useRle[f]) {
+			fprintf(out, "static const uint16_t %sOffset[] = {", font->table);
+			for (i = 0; i < count; i++) {
+				fprintf(out, "%s%u", i ? ", " : " ", Rle.glyphStart[i]);
+			}
+			fprintf(out, " };\n\n");
+		}
+	}
+
+	for (f = 0; f < sizeof(Fonts) / sizeof(Fonts[0]); f++) {
+		font = &Fonts[f];
+		fprintf(out, "FontDef %s = {%u,%u,%s,", font->name, font->width,
+				font->height, font->table);
+		if (font->chars) {
+			fprintf(out, "\"%s\",", font->chars);
+		} else {
+			fprintf(out, "NULL,");
+		}
+		if (useRle[f]) {
+			fprintf(out, "%sOffset};\n", font->table);
+		} else {
+			fprintf(out, "NULL};\n");
+		}
+	}
+	fclose(out);
+
+	printf("%s", report);
+	return 0;
+}
@@ -0,0 +1,105 @@
+/**
+ ******************************************************************************
+ * @file		i2c_sim.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		24C16 on the I2C bus, used in place of i2c.c on the host.
+ *
+ * Implements the bus calls of i2c.h the way a 24C16 answers them, so
+ * at24c.c is built unchanged for the host. The chip has no address pins,
+ * the low three bits of the device address select a block of 256 bytes
+ * and the word address byte the byte in it. A write wraps inside its page
+ * of 16 bytes, a read goes on over the whole memory. There is no write
+ * cycle, the chip answers at once.
+ ******************************************************************************
+ */
+
+#include <string.h>
+#include "i2c_sim.h"
+#include "stm32f10x_i2c.h"
+#include "i2c.h"
+
+i2c_sim_t i2csim;
+
+enum {
+	I2C_SIM_IDLE = 0,
+	I2C_SIM_WORD_ADDRESS,	// first byte after the device address
+	I2C_SIM_DATA
+};
+
+/** Private functions ------------------------------------------------------- */
+// Device address acknowledged, false if it is another chip
+static uint8_t i2csim_Address(uint8_t address) {
+	if ((address >> 1 & 0x78) != I2C_SIM_ADDR) {
+		i2csim.nacks++;
+		return 0;
+	}
+	i2csim.blocks |= 1 << (address >> 1 & 0x07);
+	return 1;
+}
+
+/** Public functions -------------------------------------------------------- */
+void i2c_start(I2C_TypeDef* I2Cx) {
+	(void) I2Cx;
+	i2csim.state = I2C_SIM_IDLE;
+}
+
+void i2c_stop(I2C_TypeDef* I2Cx) {
+	(void) I2Cx;
+	i2csim.state = I2C_SIM_IDLE;
+}
+
+// A read goes on from the address counter, only a write takes the block
+void i2c_address_direction(I2C_TypeDef* I2Cx, uint8_t address,
+		uint8_t direction) {
+	(void) I2Cx;
+	if (!i2csim_Address(address)) {
+		return;
+	}
+	if (direction == I2C_Direction_Transmitter) {
+		i2csim.pointer = (address >> 1 & 0x07) << 8;
+		i2csim.state = I2C_SIM_WORD_ADDRESS;
+	}
+}
+
+void i2c_transmit(I2C_TypeDef* I2Cx, uint8_t byte) {
+	uint16_t page = i2csim.pointer & ~(I2C_SIM_PAGESIZE - 1);
+
+	(void) I2Cx;
+	switch (i2csim.state) {
+	case I2C_SIM_WORD_ADDRESS:
+		i2csim.pointer |= byte;
+		i2csim.state = I2C_SIM_DATA;
+		break;
+	case I2C_SIM_DATA:
+		i2csim.memory[i2csim.pointer] = byte;
+		i2csim.pointer = page
+				| ((i2csim.pointer + 1) & (I2C_SIM_PAGESIZE - 1));
+		break;
+	default:
+		break;
+	}
+}
+
+uint8_t i2c_receive_ack(I2C_TypeDef* I2Cx) {
+	uint8_t byte = i2csim.memory[i2csim.pointer];
+
+	(void) I2Cx;
+	i2csim.pointer = (i2csim.pointer + 1) % I2C_SIM_SIZE;
+	return byte;
+}
+
+uint8_t i2c_receive_nack(I2C_TypeDef* I2Cx) {
+	return i2c_receive_ack(I2Cx);
+}
+
+uint8_t i2c_probe(I2C_TypeDef* I2Cx, uint8_t address) {
+	(void) I2Cx;
+	return i2csim_Address(address);
+}
+
+// Erased chip, counters cleared
+void i2csim_Reset(void) {
+	memset(&i2csim, 0, sizeof(i2csim));
+	memset(i2csim.memory, 0xFF, sizeof(i2csim.memory));
+}
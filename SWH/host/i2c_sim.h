@@ -0,0 +1,32 @@
+/**
+ ******************************************************************************
+ * @file		i2c_sim.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		24C16 on the I2C bus, used in place of i2c.c on the host.
+ ******************************************************************************
+ */
+
+#ifndef __I2C_SIM_H
+#define __I2C_SIM_H
+
+#include <stdint.h>
+
+#define I2C_SIM_SIZE		0x800
+#define I2C_SIM_PAGESIZE	0x10
+// 0x50-0x57, the low three bits are the block
+#define I2C_SIM_ADDR		0x50
+
+typedef struct {
+	uint8_t memory[I2C_SIM_SIZE];
+	uint16_t pointer;		// address counter of the chip
+	uint8_t state;			// what the next transmitted byte is
+	uint32_t blocks;		// bit of every block named in a device address
+	uint32_t nacks;			// device addresses of another chip
+} i2c_sim_t;
+
+extern i2c_sim_t i2csim;
+
+void i2csim_Reset(void);
+
+#endif	/* __I2C_SIM_H */
@@ -0,0 +1,296 @@
+/**
+ ******************************************************************************
+ * @file		packet_tool.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Encodes, decodes and tests radio packets on a PC.
+ *
+ * packet.c is built unchanged for the host, a payload captured from the
+ * radio can be read the way the hub reads it and a packet for a test node
+ * can be made without an STC.
+ *
+ * Build from the SWH directory:
+ *   gcc -std=gnu99 -Ihost/stub -I. -InRF24 -o host/packet_tool \
+ *       host/packet_tool.c nRF24/packet.c
+ *
+ * Usage:
+ *   host/packet_tool decode <hex>
+ *       header and readings of a payload, e.g. 10 01 2A 00 00 41 00
+ *   host/packet_tool encode [-n node] [-q sequence] [-f status]
+ *                           [-t sensor=value]...
+ *       payload in hex, sensor in hex, e.g. -t 00=65 -t 10=3300
+ *   host/packet_tool test [-n runs] [-s seed]
+ *       known payloads, sensors kept by index, then random packets through
+ *       encode and decode, exit code is the number of checks that failed
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "packet.h"
+
+static const char *m_errors[] = { "ok", "too short", "wrong version",
+		"bad length" };
+
+static int failed;
+
+static void PrintHex(const uint8_t *payload, uint8_t len) {
+	uint8_t i;
+
+	for (i = 0; i < len; i++) {
+		printf("%02X%s", payload[i], i + 1 < len ? " " : "\n");
+	}
+	if (len == 0) {
+		printf("\n");
+	}
+}
+
+static void PrintPacket(const packet_t *packet) {
+	uint8_t i;
+
+	printf("version %u.%u, node %u, sequence %u, status %02X\n",
+			PACKET_MAJOR(packet->version), packet->version & 0x0F,
+			packet->node, packet->sequence, packet->status);
+	for (i = 0; i < packet->count; i++) {
+		printf("  %02X %-11s %d\n", packet->readings[i].sensor,
+				PACKET_KIND(packet->readings[i].sensor) == PACKET_TEMPERATURE ?
+						"temperature" :
+				PACKET_KIND(packet->readings[i].sensor) == PACKET_BATTERY ?
+						"battery" : "unknown", packet->readings[i].value);
+	}
+}
+
+// Hex bytes from the arguments, spaces between them or not
+static int ParseHex(int argc, char **argv, uint8_t *payload) {
+	char digits[3] = { 0 };
+	int len = 0, i;
+	char *p;
+
+	for (i = 0; i < argc; i++) {
+		for (p = argv[i]; *p; p++) {
+			if (*p == ' ' || *p == ',') {
+				continue;
+			}
+			if (!p[1] || len == PACKET_MAX_SIZE + 1) {
+				return -1;
+			}
+			digits[0] = p[0];
+			digits[1] = p[1];
+			payload[len++] = strtoul(digits, NULL, 16);
+			p++;
+		}
+	}
+	return len;
+}
+
+static int Decode(int argc, char **argv) {
+	uint8_t payload[PACKET_MAX_SIZE + 1];
+	packetError_t error;
+	packet_t packet;
+	int len;
+
+	len = ParseHex(argc, argv, payload);
+	if (len < 0) {
+		fprintf(stderr, "not a payload\n");
+		return 1;
+	}
+	error = packet_Decode(payload, len, &packet);
+	if (error != PACKET_OK) {
+		printf("%d bytes: %s\n", len, m_errors[error]);
+		return 1;
+	}
+	PrintPacket(&packet);
+	return 0;
+}
+
+static int Encode(int argc, char **argv) {
+	uint8_t payload[PACKET_MAX_SIZE];
+	unsigned int sensor;
+	packet_t packet;
+	int opt, value;
+
+	packet_Init(&packet, 1, 0, 0);
+	optind = 1;
+	while ((opt = getopt(argc, argv, "n:q:f:t:")) != -1) {
+		switch (opt) {
+		case 'n':
+			packet.node = strtoul(optarg, NULL, 0);
+			break;
+		case 'q':
+			packet.sequence = strtoul(optarg, NULL, 0);
+			break;
+		case 'f':
+			packet.status = strtoul(optarg, NULL, 16);
+			break;
+		case 't':
+			if (sscanf(optarg, "%x=%d", &sensor, &value) != 2) {
+				fprintf(stderr, "reading is sensor=value\n");
+				return 1;
+			}
+			if (!packet_Add(&packet, sensor, value)) {
+				fprintf(stderr, "more than %d readings\n",
+						PACKET_MAX_READINGS);
+				return 1;
+			}
+			break;
+		default:
+			return 1;
+		}
+	}
+	PrintHex(payload, packet_Encode(&packet, payload));
+	return 0;
+}
+
+static void Check(const char *name, int ok) {
+	if (!ok) {
+		printf("  %s: failed\n", name);
+		failed++;
+	}
+}
+
+// Payload against what decode has to make of it
+static void Known(const char *name, const char *hex, packetError_t error,
+		uint8_t node, uint8_t count, int16_t first) {
+	uint8_t payload[PACKET_MAX_SIZE + 1];
+	char *argv[1] = { (char *) hex };
+	packet_t packet;
+	int len;
+
+	len = ParseHex(1, argv, payload);
+	Check(name, len >= 0 && packet_Decode(payload, len, &packet) == error
+			&& (error != PACKET_OK || (packet.node == node
+					&& packet.count == count
+					&& (count == 0 || packet.readings[0].value == first))));
+}
+
+static int SamePacket(const packet_t *a, const packet_t *b) {
+	uint8_t i;
+
+	if (a->node != b->node || a->sequence != b->sequence
+			|| a->status != b->status || a->count != b->count) {
+		return 0;
+	}
+	for (i = 0; i < a->count; i++) {
+		if (a->readings[i].sensor != b->readings[i].sensor
+				|| a->readings[i].value != b->readings[i].value) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Batch of several sensors of each kind, as the hub keeps them
+static void Values(void) {
+	int16_t temperature[4] = { 0 }, battery = 0;
+	uint8_t payload[PACKET_MAX_SIZE], taken;
+	packet_t packet, decoded;
+
+	packet_Init(&packet, 9, 1, 0);
+	packet_Add(&packet, PACKET_TEMPERATURE + 0, 65);
+	packet_Add(&packet, PACKET_TEMPERATURE + 1, -12);
+	packet_Add(&packet, PACKET_TEMPERATURE + 3, 40);
+	packet_Add(&packet, PACKET_TEMPERATURE + 5, 99);	// past the ones kept
+	packet_Add(&packet, PACKET_BATTERY, 3300);
+	packet_Add(&packet, PACKET_BATTERY + 1, 2900);	// past the ones kept
+	packet_Add(&packet, 0x20, 7);					// kind not known
+	Check("batch", packet_Decode(payload, packet_Encode(&packet, payload),
+			&decoded) == PACKET_OK && decoded.node == 9);
+
+	taken = packet_Values(&decoded, PACKET_TEMPERATURE, temperature, 4);
+	Check("temperatures", taken == 3 && temperature[0] == 65
+			&& temperature[1] == -12 && temperature[2] == 0
+			&& temperature[3] == 40);
+	taken += packet_Values(&decoded, PACKET_BATTERY, &battery, 1);
+	Check("battery", battery == 3300);
+	Check("not kept", decoded.count - taken == 3);
+}
+
+static int Test(int runs, unsigned int seed) {
+	uint8_t payload[PACKET_MAX_SIZE], len, i;
+	packet_t packet, decoded;
+	int run;
+
+	// STC before the header, collector at 65 and at -5
+	Known("legacy", "4100", PACKET_OK, 0, 1, 65);
+	Known("legacy negative", "FBFF", PACKET_OK, 0, 1, -5);
+	Known("header only", "10 03 07 00", PACKET_OK, 3, 0, 0);
+	Known("one reading", "10 01 2A 00 00 41 00", PACKET_OK, 1, 1, 65);
+	Known("newer minor", "1F 01 2A 00 00 41 00 20 01 00", PACKET_OK, 1, 2,
+			65);
+	Known("other major", "20 01 2A 00 00 41 00", PACKET_WRONG_VERSION, 0, 0,
+			0);
+	Known("too short", "10 01 2A", PACKET_TOO_SHORT, 0, 0, 0);
+	Known("cut reading", "10 01 2A 00 00 41", PACKET_BAD_LENGTH, 0, 0, 0);
+
+	// Sensors of every index, kept by index or counted as not kept
+	Values();
+
+	// Full batch fits in one payload
+	packet_Init(&packet, 5, 255, PACKET_STATUS_BOOT);
+	for (i = 0; packet_Add(&packet, PACKET_TEMPERATURE + i, -i); i++)
+		;
+	Check("full batch", i == PACKET_MAX_READINGS
+			&& packet_Encode(&packet, payload) <= PACKET_MAX_SIZE);
+
+	srand(seed);
+	for (run = 0; run < runs; run++) {
+		packet_Init(&packet, rand(), rand(), rand());
+		for (i = rand() % (PACKET_MAX_READINGS + 1); i > 0; i--) {
+			packet_Add(&packet, rand(), rand());
+		}
+		len = packet_Encode(&packet, payload);
+		if (len > PACKET_MAX_SIZE
+				|| packet_Decode(payload, len, &decoded) != PACKET_OK
+				|| !SamePacket(&packet, &decoded)) {
+			printf("  run %d: round trip failed\n", run);
+			PrintHex(payload, len);
+			failed++;
+		}
+	}
+
+	printf("%d runs, seed %u, %d failed\n", runs, seed, failed);
+	return failed;
+}
+
+static int Usage(void) {
+	fprintf(stderr, "usage: packet_tool decode <hex>\n"
+			"       packet_tool encode [-n node] [-q sequence] [-f status] "
+			"[-t sensor=value]...\n"
+			"       packet_tool test [-n runs] [-s seed]\n");
+	return 255;
+}
+
+int main(int argc, char **argv) {
+	unsigned int seed = time(NULL);
+	int runs = 10000, opt;
+
+	if (argc < 2) {
+		return Usage();
+	}
+	if (strcmp(argv[1], "decode") == 0 && argc > 2) {
+		return Decode(argc - 2, argv + 2);
+	}
+	if (strcmp(argv[1], "encode") == 0) {
+		return Encode(argc - 1, argv + 1);
+	}
+	if (strcmp(argv[1], "test") == 0) {
+		optind = 2;
+		while ((opt = getopt(argc, argv, "n:s:")) != -1) {
+			switch (opt) {
+			case 'n':
+				runs = atoi(optarg);
+				break;
+			case 's':
+				seed = strtoul(optarg, NULL, 0);
+				break;
+			default:
+				return Usage();
+			}
+		}
+		return Test(runs, seed);
+	}
+	return Usage();
+}
@@ -0,0 +1,398 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_emu.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		SSD1306 emulator used in place of ssd1306_i2c.c on the host.
+ *
+ * Implements the transport functions from ssd1306_i2c.h. Every call is one
+ * I2C transfer: the command/data stream is decoded into the display RAM the
+ * same way the controller does it, and the transfers and bytes that would
+ * be put on the wire are counted.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "ssd1306_emu.h"
+#include "ssd1306_i2c.h"
+
+// Arguments of the longest command, content scroll
+#define EMU_MAX_ARGS		7
+
+ssd1306_emu_t emu;
+
+// Command decoder state, arguments may arrive in separate transfers
+static uint8_t cmd;
+static uint8_t argCount;
+static uint8_t argIndex;
+static uint8_t args[EMU_MAX_ARGS];
+
+/** Private functions ------------------------------------------------------- */
+static uint8_t emu_ArgCount(uint8_t command) {
+	switch (command) {
+	case 0x20: // memory addressing mode
+	case 0x81: // contrast
+	case 0x8D: // charge pump
+	case 0xA8: // multiplex ratio
+	case 0xD3: // display offset
+	case 0xD5: // clock divide
+	case 0xD9: // pre-charge period
+	case 0xDA: // COM pins
+	case 0xDB: // VCOMH
+		return 1;
+	case 0x21: // column address
+	case 0x22: // page address
+	case 0xA3: // vertical scroll area
+		return 2;
+	case 0x29: // vertical and right horizontal scroll
+	case 0x2A: // vertical and left horizontal scroll
+		return 5;
+	case 0x26: // right horizontal scroll
+	case 0x27: // left horizontal scroll
+		return 6;
+	case 0x2C: // content scroll right
+	case 0x2D: // content scroll left
+		return EMU_MAX_ARGS;
+	default:
+		return 0;
+	}
+}
+
+// One step of content scroll, rotates the window of the display RAM
+static void emu_ContentScroll(uint8_t left) {
+	uint8_t page, first, last, edge;
+
+	first = args[5] & 0x7F;
+	last = args[6] & 0x7F;
+	if (first >= last) {
+		return;
+	}
+	for (page = args[1] & 0x07; page <= (args[3] & 0x07); page++) {
+		if (left) {
+			edge = emu.ram[page][first];
+			memmove(&emu.ram[page][first], &emu.ram[page][first + 1],
+					last - first);
+			emu.ram[page][last] = edge;
+		} else {
+			edge = emu.ram[page][last];
+			memmove(&emu.ram[page][first + 1], &emu.ram[page][first],
+					last - first);
+			emu.ram[page][first] = edge;
+		}
+	}
+}
+
+static void emu_Execute(void) {
+	if (cmd <= 0x1F || (cmd >= 0xB0 && cmd <= 0xB7)) {
+		// Page addressing commands, ignored by the controller in other modes
+		if (emu.mode != 2) {
+			return;
+		}
+		if (cmd <= 0x0F) {
+			emu.column = (emu.column & 0xF0) | cmd;
+		} else if (cmd <= 0x1F) {
+			emu.column = (emu.column & 0x0F) | ((cmd & 0x0F) << 4);
+		} else {
+			emu.page = cmd & 0x07;
+		}
+	} else if (cmd >= 0x40 && cmd <= 0x7F) {
+		emu.startLine = cmd & 0x3F;
+	} else {
+		switch (cmd) {
+		case 0x20:
+			emu.mode = args[0] & 0x03;
+			break;
+		case 0x21:
+			emu.colStart = args[0] & 0x7F;
+			emu.colEnd = args[1] & 0x7F;
+			if (emu.mode != 2) {
+				emu.column = emu.colStart;
+			}
+			break;
+		case 0x22:
+			emu.pageStart = args[0] & 0x07;
+			emu.pageEnd = args[1] & 0x07;
+			if (emu.mode != 2) {
+				emu.page = emu.pageStart;
+			}
+			break;
+		case 0x2C:
+		case 0x2D:
+			emu_ContentScroll(cmd == 0x2D);
+			break;
+		case 0x2E:
+			emu.scrolling = 0;
+			break;
+		case 0x2F:
+			emu.scrolling = 1;
+			break;
+		case 0xA6:
+			emu.inverse = 0;
+			break;
+		case 0xA7:
+			emu.inverse = 1;
+			break;
+		case 0xAE:
+			emu.displayOn = 0;
+			break;
+		case 0xAF:
+			emu.displayOn = 1;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void emu_Command(uint8_t byte) {
+	if (argIndex < argCount) {
+		args[argIndex++] = byte;
+	} else {
+		cmd = byte;
+		argCount = emu_ArgCount(byte);
+		argIndex = 0;
+	}
+	if (argIndex == argCount) {
+		emu_Execute();
+	}
+}
+
+static void emu_Data(uint8_t byte) {
+	emu.ram[emu.page][emu.column] = byte;
+	emu.dataBytes++;
+
+	switch (emu.mode) {
+	case 0: // horizontal: column first, then page, inside the window
+		if (emu.column >= emu.colEnd) {
+			emu.column = emu.colStart;
+			emu.page = (emu.page >= emu.pageEnd) ? emu.pageStart : emu.page + 1;
+		} else {
+			emu.column++;
+		}
+		break;
+	case 1: // vertical: page first, then column
+		if (emu.page >= emu.pageEnd) {
+			emu.page = emu.pageStart;
+			emu.column = (emu.column >= emu.colEnd) ? emu.colStart : emu.column + 1;
+		} else {
+			emu.page++;
+		}
+		break;
+	default: // page addressing: column wraps inside the page
+		emu.column = (emu.column + 1) & 0x7F;
+		break;
+	}
+}
+
+/** Transport (ssd1306_i2c.h) ----------------------------------------------- */
+void ssd1306_Reset(void) {
+	emu_Reset();
+}
+
+void ssd1306_WriteCommand(uint8_t byte) {
+	emu.transactions++;
+	emu.bytes += 3; // address, control, command
+	emu_Command(byte);
+}
+
+void ssd1306_WriteCommands(uint8_t* buffer, uint16_t buff_size) {
+	uint16_t i;
+	emu.transactions++;
+	emu.bytes += 2 + buff_size;
+	for (i = 0; i < buff_size; i++) {
+		emu_Command(buffer[i]);
+	}
+}
+
+void ssd1306_WriteData(uint8_t* buffer, uint16_t buff_size) {
+	uint16_t i;
+	emu.transactions++;
+	emu.bytes += 2 + buff_size;
+	for (i = 0; i < buff_size; i++) {
+		emu_Data(buffer[i]);
+	}
+}
+
+/** Public functions -------------------------------------------------------- */
+// Power-on state of the controller
+void emu_Reset(void) {
+	memset(&emu, 0, sizeof(emu));
+	emu.mode = 2;
+	emu.colEnd = EMU_WIDTH - 1;
+	emu.pageEnd = EMU_PAGES - 1;
+	argCount = 0;
+	argIndex = 0;
+}
+
+void emu_ResetCounters(void) {
+	emu.transactions = 0;
+	emu.bytes = 0;
+	emu.dataBytes = 0;
+}
+
+// Pixel as seen on the panel: start line and inverse applied
+uint8_t emu_GetPixel(uint8_t x, uint8_t y) {
+	uint8_t row = (y + emu.startLine) % EMU_HEIGHT;
+	uint8_t on = (emu.ram[row / 8][x] >> (row % 8)) & 1;
+
+	if (!emu.displayOn) {
+		return 0;
+	}
+	return on ^ emu.inverse;
+}
+
+// Binary PBM, lit pixels are written white
+int emu_WritePBM(const char *path) {
+	FILE *f;
+	uint8_t x, y;
+	uint8_t row[EMU_WIDTH / 8];
+
+	f = fopen(path, "wb");
+	if (f == NULL) {
+		return -1;
+	}
+	fprintf(f, "P4\n%d %d\n", EMU_WIDTH, EMU_HEIGHT);
+	for (y = 0; y < EMU_HEIGHT; y++) {
+		memset(row, 0xFF, sizeof(row));
+		for (x = 0; x < EMU_WIDTH; x++) {
+			if (emu_GetPixel(x, y)) {
+				row[x / 8] &= ~(0x80 >> (x % 8));
+			}
+		}
+		fwrite(row, 1, sizeof(row), f);
+	}
+	fclose(f);
+	return 0;
+}
+
+static uint32_t crcTable[256];
+
+static uint32_t png_Crc(uint32_t crc, const uint8_t *buf, uint32_t len) {
+	uint32_t c, n, k;
+
+	if (crcTable[1] == 0) {
+		for (n = 0; n < 256; n++) {
+			c = n;
+			for (k = 0; k < 8; k++) {
+				c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+			}
+			crcTable[n] = c;
+		}
+	}
+	crc = ~crc;
+	while (len--) {
+		crc = crcTable[(crc ^ *buf++) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+static void png_Put32(uint8_t *p, uint32_t v) {
+	p[0] = v >> 24;
+	p[1] = v >> 16;
+	p[2] = v >> 8;
+	p[3] = v;
+}
+
+static void png_Chunk(FILE *f, const char *type, const uint8_t *data,
+		uint32_t len) {
+	uint8_t hdr[8];
+	uint32_t crc;
+
+	png_Put32(hdr, len);
+	memcpy(&hdr[4], type, 4);
+	crc = png_Crc(0, &hdr[4], 4);
+	crc = png_Crc(crc, data, len);
+	fwrite(hdr, 1, 8, f);
+	fwrite(data, 1, len, f);
+	png_Put32(hdr, crc);
+	fwrite(hdr, 1, 4, f);
+}
+
+// 8-bit grayscale PNG, image data stored in one uncompressed deflate block
+int emu_WritePNG(const char *path) {
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n',
+			0x1A, '\n' };
+	enum {
+		RAW = EMU_HEIGHT * (EMU_WIDTH + 1)
+	};
+	uint8_t ihdr[13];
+	uint8_t idat[2 + 5 + RAW + 4];
+	uint8_t *raw = &idat[7];
+	uint32_t a = 1, b = 0, i;
+	uint8_t x, y;
+	FILE *f;
+
+	f = fopen(path, "wb");
+	if (f == NULL) {
+		return -1;
+	}
+
+	png_Put32(&ihdr[0], EMU_WIDTH);
+	png_Put32(&ihdr[4], EMU_HEIGHT);
+	ihdr[8] = 8; // bit depth
+	ihdr[9] = 0; // grayscale
+	ihdr[10] = 0;
+	ihdr[11] = 0;
+	ihdr[12] = 0;
+
+	idat[0] = 0x78; // zlib header, no compression
+	idat[1] = 0x01;
+	idat[2] = 0x01; // final stored block
+	idat[3] = RAW & 0xFF;
+	idat[4] = RAW >> 8;
+	idat[5] = ~RAW & 0xFF;
+	idat[6] = (~RAW >> 8) & 0xFF;
+	for (y = 0; y < EMU_HEIGHT; y++) {
+		*raw++ = 0; // filter: none
+		for (x = 0; x < EMU_WIDTH; x++) {
+			*raw++ = emu_GetPixel(x, y) ? 0xFF : 0x00;
+		}
+	}
+	for (i = 0; i < RAW; i++) {
+		a = (a + idat[7 + i]) % 65521;
+		b = (b + a) % 65521;
+	}
+	png_Put32(raw, (b << 16) | a);
+
+	fwrite(signature, 1, sizeof(signature), f);
+	png_Chunk(f, "IHDR", ihdr, sizeof(ihdr));
+	png_Chunk(f, "IDAT", idat, sizeof(idat));
+	png_Chunk(f, "IEND", NULL, 0);
+	fclose(f);
+	return 0;
+}
+
+// Compare panel with a PBM written by emu_WritePBM
+// returns number of different pixels or -1 if the file can't be used
+int emu_ComparePBM(const char *path) {
+	FILE *f;
+	int w, h, diff = 0;
+	uint8_t x, y;
+	uint8_t row[EMU_WIDTH / 8];
+	uint8_t golden;
+
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		return -1;
+	}
+	if (fscanf(f, "P4 %d %d", &w, &h) != 2 || w != EMU_WIDTH
+			|| h != EMU_HEIGHT || fgetc(f) == EOF) {
+		fclose(f);
+		return -1;
+	}
+	for (y = 0; y < EMU_HEIGHT; y++) {
+		if (fread(row, 1, sizeof(row), f) != sizeof(row)) {
+			fclose(f);
+			return -1;
+		}
+		for (x = 0; x < EMU_WIDTH; x++) {
+			golden = !(row[x / 8] & (0x80 >> (x % 8)));
+			if (golden != emu_GetPixel(x, y)) {
+				diff++;
+			}
+		}
+	}
+	fclose(f);
+	return diff;
+}
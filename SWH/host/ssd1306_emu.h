@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_emu.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		SSD1306 emulator used in place of ssd1306_i2c.c on the host.
+ ******************************************************************************
+ */
+
+#ifndef __SSD1306_EMU_H
+#define __SSD1306_EMU_H
+
+#include <stdint.h>
+
+#define EMU_WIDTH			128
+#define EMU_PAGES			8
+#define EMU_HEIGHT			(EMU_PAGES * 8)
+
+typedef struct {
+	uint8_t ram[EMU_PAGES][EMU_WIDTH];	// display data RAM
+	uint8_t mode;			// 0 horizontal, 1 vertical, 2 page addressing
+	uint8_t page;
+	uint8_t column;
+	uint8_t colStart, colEnd;	// window for horizontal/vertical mode
+	uint8_t pageStart, pageEnd;
+	uint8_t startLine;
+	uint8_t inverse;
+	uint8_t displayOn;
+	uint8_t scrolling;
+	uint32_t transactions;	// I2C transfers (START ... STOP)
+	uint32_t bytes;			// bytes on the wire, address byte included
+	uint32_t dataBytes;		// display RAM bytes written
+} ssd1306_emu_t;
+
+extern ssd1306_emu_t emu;
+
+void emu_Reset(void);
+void emu_ResetCounters(void);
+uint8_t emu_GetPixel(uint8_t x, uint8_t y);
+int emu_WritePBM(const char *path);
+int emu_WritePNG(const char *path);
+int emu_ComparePBM(const char *path);
+
+#endif	/* __SSD1306_EMU_H */
@@ -0,0 +1,272 @@
+/**
+ ******************************************************************************
+ * @file		ssd1306_host.c
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Renders the OLED screens on a PC.
+ *
+ * The display code (ssd1306, gfx, fonts, scene, trend and displayController)
+ * is built unchanged for the host, only ssd1306_i2c.c is replaced with the
+ * emulator from ssd1306_emu.c and the rollups with a fixed day. Every frame
+ * is written as PBM and PNG and the I2C traffic of each flush is printed,
+ * so a layout or a driver change can be checked without flashing the
+ * board.
+ *
+ * Build from the SWH directory:
+ *   gcc -std=gnu99 -Ihost/stub -I. -ILcd -IDS1820 -IRTC -InRF24 -IEEPROM \
+ *       -o host/ssd1306_host host/ssd1306_host.c host/ssd1306_emu.c \
+ *       Lcd/ssd1306.c Lcd/ssd1306_gfx.c Lcd/ssd1306_fonts.c \
+ *       Lcd/ssd1306_scene.c Lcd/ssd1306_trend.c displayController.c
+ *
+ * Usage:
+ *   host/ssd1306_host [-o outdir] [-g goldendir] [-u]
+ *   -o  where frames are written (default .)
+ *   -g  compare every frame with <goldendir>/<frame>.pbm, exit code is the
+ *       number of frames that differ or have no golden image
+ *   -u  write the frames into the golden directory instead of comparing
+ *
+ * The golden images of the current screens are in host/golden, checked with
+ * -g host/golden and written again with -g host/golden -u after a change
+ * to the screens that is meant to be.
+ ******************************************************************************
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "ssd1306_emu.h"
+#include "ssd1306.h"
+#include "ssd1306_gfx.h"
+#include "displayController.h"
+#include "nrf24_mid_level.h"
+#include "ds1820.h"
+#include "ds1307_mid_level.h"
+#include "rollup.h"
+
+/** Values the screens are bound to ----------------------------------------- */
+volatile uint32_t micros;
+int16_t m_temperature[2];
+uint8_t m_boilerPump;
+uint8_t m_collectorPump;
+nrf24Node_t nrf24Nodes[NRF24_NODES];
+
+extern uint8_t m_displayCounter;
+
+// Day the today screen shows
+static rollup_t today = { .seconds = 43200, .boilerPump = 5400,
+		.collectorPump = 15780, .link = 41000, .max = { 87, 62, 71 },
+		.valid = 0x05 };
+
+const rollup_t *rollup_Current(uint8_t period) {
+	(void) period;
+	return &today;
+}
+
+// Cache the screens read the time from, ReadTime isn't called on the host
+TimeStruct_t m_time = { .year = 26, .month = 10, .date = 19, .hours_24 = 12,
+		.minutes = 34, .seconds = 56 };
+
+/** Frames ------------------------------------------------------------------ */
+static const char *outDir = ".";
+static const char *goldenDir = NULL;
+static uint8_t updateGolden;
+static int failed;
+
+static void Snapshot(const char *name) {
+	char path[256];
+	int diff;
+
+	printf("%-20s %4u transfers %6u bytes %5u data\n", name,
+			(unsigned) emu.transactions, (unsigned) emu.bytes,
+			(unsigned) emu.dataBytes);
+
+	snprintf(path, sizeof(path), "%s/%s.png", outDir, name);
+	emu_WritePNG(path);
+	snprintf(path, sizeof(path), "%s/%s.pbm", outDir, name);
+	emu_WritePBM(path);
+
+	if (goldenDir == NULL) {
+		return;
+	}
+	snprintf(path, sizeof(path), "%s/%s.pbm", goldenDir, name);
+	if (updateGolden) {
+		emu_WritePBM(path);
+		return;
+	}
+	diff = emu_ComparePBM(path);
+	if (diff < 0) {
+		printf("  %s: no golden image, failed\n", path);
+		failed++;
+	} else if (diff > 0) {
+		printf("  %s: %d pixels differ\n", path, diff);
+		failed++;
+	}
+}
+
+// Second tick of the application: advance the clock and call UpdateDisplay
+static void Tick(void) {
+	if (++m_time.seconds >= 60) {
+		m_time.seconds = 0;
+		m_time.minutes++;
+	}
+	micros += 1000000;
+	emu_ResetCounters();
+	UpdateDisplay();
+}
+
+static void FramePrimitives(void) {
+	ssd1306_Fill(Black);
+	ssd1306_SetCursor(0, 0);
+	ssd1306_WriteString("Font 7x10", Font_7x10, White);
+	ssd1306_SetCursor(0, 12);
+	ssd1306_WriteString("-12.3", Font_11x18, White);
+	ssd1306_SetCursor(70, 34);
+	ssd1306_WriteString("+45", Font_16x26, White);
+	ssd1306_DrawRect(70, 0, 58, 30, White);
+	ssd1306_FillRect(74, 4, 20, 22, White);
+	ssd1306_DrawLine(96, 4, 124, 26, White);
+	ssd1306_DrawLine(96, 26, 124, 4, White);
+	ssd1306_DrawCircle(16, 48, 14, White);
+	ssd1306_FillCircle(48, 48, 14, White);
+	ssd1306_DrawHLine(0, 32, 64, White);
+	emu_ResetCounters();
+	ssd1306_UpdateScreen();
+	Snapshot("primitives");
+}
+
+static void FrameScreens(void) {
+	m_temperature[0] = 65;
+	m_temperature[1] = 48;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].temperature[0] = -5;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].connected = true;
+	m_boilerPump = true;
+	m_collectorPump = false;
+
+	m_displayCounter = 0;
+	Tick();
+	Snapshot("time_show");
+	Tick();
+	Snapshot("time_update");
+	Tick();
+	Snapshot("time_update2");
+
+	Tick();
+	Snapshot("temperature_show");
+	Tick();
+	Snapshot("temperature_steady");
+	m_temperature[0] = 102;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].connected = false;
+	m_collectorPump = true;
+	Tick();
+	Snapshot("temperature_update");
+}
+
+static void FrameTrend(void) {
+	char path[256];
+	uint16_t minute, i;
+	int diff;
+
+	// Two hours of history, collector disconnected for a while
+	for (minute = 0; minute < 150; minute++) {
+		m_temperature[T_WATER_HEATER] = 40 + minute / 10;
+		m_temperature[T_BOILER] = 55 + (minute % 40 < 20 ? minute % 20
+				: 20 - minute % 20);
+		nrf24Nodes[NRF24_NODE_COLLECTOR].temperature[0] = 10
+				+ (minute * 3) % 110;
+		nrf24Nodes[NRF24_NODE_COLLECTOR].connected = (minute < 60
+				|| minute > 75);
+		for (i = 0; i < 60; i++) {
+			UpdateDisplay();
+		}
+	}
+
+	m_displayCounter = 6;
+	Tick();
+	Snapshot("trend_show");
+
+	// Stay on the trend screen until the next sample arrives
+	for (i = 0; i < 60; i++) {
+		m_displayCounter = 7;
+		Tick();
+		if (emu.transactions) {
+			break;
+		}
+	}
+	// New column goes out on the pass after the content scroll is done
+	micros += SSD1306_SCROLL_TIME;
+	UpdateDisplay();
+	Snapshot("trend_scroll");
+
+	// Scrolled display RAM must be the same as a full redraw
+	m_displayCounter = 6;
+	Tick();
+	snprintf(path, sizeof(path), "%s/trend_scroll.pbm", outDir);
+	diff = emu_ComparePBM(path);
+	if (diff != 0) {
+		printf("  scrolled trend differs from redraw: %d\n", diff);
+		failed++;
+	}
+}
+
+static void FrameToday(void) {
+	m_displayCounter = 9;
+	Tick();
+	Snapshot("today_show");
+}
+
+static void FrameNodes(void) {
+	nrf24Nodes[0].temperature[0] = 21;
+	nrf24Nodes[0].connected = true;
+	nrf24Nodes[0].received = 40;
+	nrf24Nodes[0].quality = 100;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].temperature[0] = 87;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].connected = true;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].received = 1200;
+	nrf24Nodes[NRF24_NODE_COLLECTOR].quality = 75;
+	nrf24Nodes[3].temperature[0] = -12;
+	nrf24Nodes[3].connected = false;
+	nrf24Nodes[3].received = 3;
+	nrf24Nodes[3].quality = 0;
+
+	m_displayCounter = 12;
+	Tick();
+	Snapshot("nodes_show");
+}
+
+int main(int argc, char *argv[]) {
+	int opt;
+
+	while ((opt = getopt(argc, argv, "o:g:u")) != -1) {
+		switch (opt) {
+		case 'o':
+			outDir = optarg;
+			break;
+		case 'g':
+			goldenDir = optarg;
+			break;
+		case 'u':
+			updateGolden = 1;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-o outdir] [-g goldendir] [-u]\n",
+					argv[0]);
+			return 255;
+		}
+	}
+
+	ssd1306_Init();
+	printf("%-20s %4u transfers %6u bytes %5u data\n", "init",
+			(unsigned) emu.transactions, (unsigned) emu.bytes,
+			(unsigned) emu.dataBytes);
+
+	FramePrimitives();
+	FrameScreens();
+	FrameTrend();
+	FrameToday();
+	FrameNodes();
+
+	if (failed) {
+		printf("%d frame(s) differ from golden images\n", failed);
+	}
+	return failed;
+}
@@ -0,0 +1,20 @@
+/**
+ ******************************************************************************
+ * @file		debugUsart.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in, debug.printf is set by the host program.
+ ******************************************************************************
+ */
+
+#ifndef __DEBUG_USART_H
+#define __DEBUG_USART_H
+
+extern struct debug_t {
+	int (*printf)(const char *, ...);
+} debug;
+
+#define DebugChangeColorToRED()
+#define DebugChangeColorToGREEN()
+
+#endif
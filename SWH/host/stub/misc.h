@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file		misc.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in, see stm32f10x.h
+ ******************************************************************************
+ */
+
+#ifndef __MISC_H
+#define __MISC_H
+
+#include "stm32f10x.h"
+
+#endif	/* __MISC_H */
@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file		stm32f10x.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in for the device header, only the types
+ *				that the display code sees through its includes.
+ ******************************************************************************
+ */
+
+#ifndef __STM32F10x_H
+#define __STM32F10x_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct {
+	uint32_t dummy;
+} I2C_TypeDef;
+
+typedef struct {
+	uint32_t dummy;
+} GPIO_TypeDef;
+
+#define I2C1				((I2C_TypeDef *) 0)
+#define I2C2				((I2C_TypeDef *) 0)
+
+#endif	/* __STM32F10x_H */
@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file		stm32f10x_gpio.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in, see stm32f10x.h
+ ******************************************************************************
+ */
+
+#ifndef __STM32F10X_GPIO_H
+#define __STM32F10X_GPIO_H
+
+#include "stm32f10x.h"
+
+#endif	/* __STM32F10X_GPIO_H */
@@ -0,0 +1,18 @@
+/**
+ ******************************************************************************
+ * @file		stm32f10x_i2c.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in, see stm32f10x.h
+ ******************************************************************************
+ */
+
+#ifndef __STM32F10X_I2C_H
+#define __STM32F10X_I2C_H
+
+#include "stm32f10x.h"
+
+#define I2C_Direction_Transmitter	((uint8_t) 0x00)
+#define I2C_Direction_Receiver		((uint8_t) 0x01)
+
+#endif	/* __STM32F10X_I2C_H */
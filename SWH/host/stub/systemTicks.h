@@ -0,0 +1,29 @@
+/**
+ ******************************************************************************
+ * @file		systemTicks.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ * @brief		Host build stand-in, there is nothing to wait for.
+ ******************************************************************************
+ */
+
+#ifndef _SYSTEMTICK_H
+#define _SYSTEMTICK_H
+
+#include "stm32f10x.h"
+
+#define SYSTICK     1000000
+
+#define _ONE_SEC SYSTICK
+
+#define TIME(x) (const) ((float) x * SYSTICK)
+
+#define _DelayMS(x)
+#define _DelayUS(x)
+
+#define CYCLES()	0
+#define InitCycleCounter()
+
+extern volatile uint32_t micros;
+
+#endif
@@ -11,6 +11,8 @@
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_i2c.h"
 #include "i2c.h"
+#include "systemTicks.h"
+#include "defines.h"
 
 /** Public functions ------------------------------------------------------- */
 /**
@@ -187,3 +189,35 @@ uint8_t i2c_receive_nack(I2C_TypeDef* I2Cx) {
 	return I2C_ReceiveData(I2Cx);
 }
 
+/**
+ ******************************************************************************
+ *	@brief	Check if a slave acknowledges its address, without waiting
+ *			forever when it doesn't
+ * @param   I2Cx: where x can be 1 or 2 to select the I2C peripheral.
+ * @param	Slave address
+ * @retval	true if the slave answered with ACK, false otherwise
+ ******************************************************************************
+ */
+uint8_t i2c_probe(I2C_TypeDef* I2Cx, uint8_t address) {
+	uint32_t start;
+	uint8_t ack = false;
+
+	i2c_start(I2Cx);
+	I2C_Send7bitAddress(I2Cx, address, I2C_Direction_Transmitter);
+
+	start = micros;
+	while (!TIMEOUT(start, I2C_PROBE_TIMEOUT)) {
+		if (I2C_CheckEvent(I2Cx, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED)) {
+			ack = true;
+			break;
+		}
+		// NACK, slave isn't there or is busy
+		if (I2C_GetFlagStatus(I2Cx, I2C_FLAG_AF)) {
+			I2C_ClearFlag(I2Cx, I2C_FLAG_AF);
+			break;
+		}
+	}
+	i2c_stop(I2Cx);
+
+	return ack;
+}
@@ -16,6 +16,10 @@ extern "C" {
 /** Includes ---------------------------------------------------------------- */
 #include "stm32f10x.h"
 
+/** Defines ----------------------------------------------------------------- */
+// How long to wait for a slave to acknowledge its address, in us
+#define I2C_PROBE_TIMEOUT			1000
+
 /** Public function prototypes ---------------------------------------------- */
 void init_i2c1_master(void);
 void init_i2c2_master(void);
@@ -26,6 +30,7 @@ void i2c_address_direction(I2C_TypeDef* I2Cx, uint8_t address, uint8_t direction
 void i2c_transmit(I2C_TypeDef* I2Cx, uint8_t byte);
 uint8_t i2c_receive_ack(I2C_TypeDef* I2Cx);
 uint8_t i2c_receive_nack(I2C_TypeDef* I2Cx);
+uint8_t i2c_probe(I2C_TypeDef* I2Cx, uint8_t address);
 
 #ifdef __cplusplus
 }
@@ -20,34 +20,30 @@
 #include "task.h"
 #include "debugMsg.h"
 #include "nrf24_mid_level.h"
+#include "nrf24_low_level.h"
 #include "i2c.h"
 #include "eeprom.h"
+#include "at24c.h"
+#include "journal.h"
 #include "ssd1306.h"
 #include "ds1307.h"
 #include "ds1307_mid_level.h"
+#include "clock.h"
 #include "mainController.h"
-
-uint8_t m_displayCounter;
-
-void UpdateDisplay(void) {
-	if (m_displayCounter < 3) {
-		DisplayTime();
-	} else {
-		DisplayTemperatures();
-	}
-	m_displayCounter++;
-	if (m_displayCounter >= 6)
-		m_displayCounter = 0;
-}
+#include "displayController.h"
 
 void DefineTasks(void) {
 	InitTasks();
 
 	AddTaskSignal(&CheckConsoleRx, &m_DebugMsgReceived, true);
 	AddTaskTime(&MeasureTemperatures, TIME(0.5), true);
+	AddTaskTime(&ReadTime, TIME(1), true);
 	AddTaskTime(&UpdateDisplay, TIME(1), true);
 	AddTaskTime(&WaterPumpController, TIME(1), true);
-	AddTaskTime(&nRF24_Receive, TIME(0.001), true);
+	AddTaskTime(&SampleRollups, TIME(1), true);
+	AddTaskSignal(&nRF24_Receive, &m_nRF24Irq, true);
+	AddTaskTime(&nRF24_CheckLink, TIME(0.1), true);
+	AddTaskTime(&journal_Task, JOURNAL_TASK_PERIOD, true);
 
 	AddTaskTime(&PrintTasks, TIME(1), false);
 	AddTaskTime(&TaskManager, TIME(1), false);
@@ -73,6 +69,12 @@ void Init(void) {
 
 	init_i2c1_master();
 	init_i2c2_master();
+	blockdev_Init(&At24cDevice);
+	debug.printf("EEPROM: %s\r\n", blockdev_Geometry()->name);
+	clock_Init();
+	debug.printf("Time source: %s\r\n",
+			clock_GetSource() ? clock_GetSource()->name : "none");
+	ReadTime();
 
 	InitWaterPump();
 
@@ -18,9 +18,15 @@
 #include "ds1820.h"
 #include "ds1307.h"
 #include "ds1307_mid_level.h"
+#include "clock.h"
 #include "nrf24_mid_level.h"
 #include "debugUsart.h"
+#include "systemTicks.h"
 #include "eeprom.h"
+#include "history.h"
+#include "journal.h"
+#include "rollup.h"
+#include "config.h"
 
 #define BOILER_PORT			GPIOA
 #define BOILER_GPIO			GPIO_Pin_9
@@ -28,10 +34,11 @@
 #define COLLECTOR_PORT		GPIOA
 #define COLLECTOR_GPIO		GPIO_Pin_10
 
+#define HISTORY_PRINT_COUNT	10
+
 uint8_t m_boilerPump;
 uint8_t m_collectorPump;
 
-uint8_t m_currentIndex;
 uint8_t m_deltaPlus;
 uint8_t m_deltaMinus;
 
@@ -60,7 +67,10 @@ void Set_Collector_Pump(uint8_t aEnabled) {
 }
 
 void PrintHistoryData(historyData_t data) {
-	PrintTime(&data.time);
+	TimeStruct_t time;
+
+	clock_ToTime(data.timestamp, &time);
+	PrintTime(&time);
 	debug.printf(" %02dC, %02dC, %02dC", data.tempCollector,
 			data.tempWaterHeater, data.tempBoiler);
 	debug.printf(" %d, %d, %s\r\n", data.status.bits.collectorPump,
@@ -71,50 +81,30 @@ void PrintDelta(void) {
 	debug.printf("DELTA +: %d, DELTA -: %d\r\n", m_deltaPlus, m_deltaMinus);
 }
 
+void GetCurrentData(historyData_t *data) {
+	data->timestamp = clock_Now();
+
+	data->status.B = 0;
+	data->status.bits.boilerPump = m_boilerPump;
+	data->status.bits.collectorPump = m_collectorPump;
+	data->status.bits.nRFComm = nrf24Nodes[NRF24_NODE_COLLECTOR].connected;
+	data->reserved = 0;
+
+	data->tempBoiler = m_temperature[T_BOILER];
+	data->tempWaterHeater = m_temperature[T_WATER_HEATER];
+	data->tempCollector = nrf24Nodes[NRF24_NODE_COLLECTOR].temperature[0];
+}
+
 void SetAndWriteCurrentData(void) {
-	if (m_currentIndex < (MAX_NUMBER_OF_HISTORIES - 1)) {
-		++m_currentIndex;
-	} else {
-		m_currentIndex = 0;
-	}
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.date =
-			ds1307_get_date();
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.month =
-			ds1307_get_month();
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.year =
-			ds1307_get_year();
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.hours_24 =
-			ds1307_get_hours_24();
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.minutes =
-			ds1307_get_minutes();
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].time.seconds =
-			ds1307_get_seconds();
-
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].status.bits.boilerPump =
-			m_boilerPump;
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].status.bits.collectorPump =
-			m_collectorPump;
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].status.bits.nRFComm =
-			nrf24Data.connected;
-
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].tempBoiler =
-			m_temperature[T_BOILER];
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].tempWaterHeater =
-			m_temperature[T_WATER_HEATER];
-	m_EEPROM_Array.Payload.Item.data[m_currentIndex].tempCollector =
-			m_tCollector.i;
-
-	m_EEPROM_Array.Payload.Item.currentIndex = m_currentIndex;
-
-	at24c_write();
-	PrintHistoryData(m_EEPROM_Array.Payload.Item.data[m_currentIndex]);
+	historyData_t data;
+
+	GetCurrentData(&data);
+	journal_AddHistory(&data);
+	PrintHistoryData(data);
 }
 
 void SetAndWriteDelta(void) {
-	m_EEPROM_Array.Payload.Item.deltaPlus = m_deltaPlus;
-	m_EEPROM_Array.Payload.Item.deltaMinus = m_deltaMinus;
-
-	at24c_write();
+	journal_SetDelta(m_deltaPlus, m_deltaMinus);
 	PrintDelta();
 }
 
@@ -163,6 +153,8 @@ void InitWaterPump(void) {
 }
 
 void WaterPumpController(void) {
+	const nrf24Node_t *collector = &nrf24Nodes[NRF24_NODE_COLLECTOR];
+
 	if (TemperatureIsValid(m_temperature[T_WATER_HEATER])) {
 		if (TemperatureIsValid(m_temperature[T_BOILER])) {
 			if (m_temperature[T_BOILER]
@@ -176,13 +168,13 @@ void WaterPumpController(void) {
 			}
 		}
 
-		if (nrf24Data.connected) {
-			if (TemperatureIsValid(m_tCollector.i)) {
-				if (m_tCollector.i
+		if (collector->connected) {
+			if (TemperatureIsValid(collector->temperature[0])) {
+				if (collector->temperature[0]
 						>= (m_temperature[T_WATER_HEATER] + m_deltaPlus)
 						&& !m_collectorPump) {
 					TurnOnCollectorPump();
-				} else if (m_tCollector.i
+				} else if (collector->temperature[0]
 						<= (m_temperature[T_WATER_HEATER] + m_deltaMinus)
 						&& m_collectorPump) {
 					TurnOffCollectorPump();
@@ -196,27 +188,107 @@ void WaterPumpController(void) {
 	}
 }
 
+// Last HISTORY_PRINT_COUNT records, oldest first
 void PrintHistory(void) {
+	historyData_t data;
+	uint16_t count = history_Count();
+	uint16_t i;
+
+	if (count > HISTORY_PRINT_COUNT) {
+		count = HISTORY_PRINT_COUNT;
+	}
+	for (i = count; i > 0; i--) {
+		debug.printf("%d. ", count - i);
+		if (history_Get(i - 1, &data)) {
+			PrintHistoryData(data);
+		} else {
+			debug.printf("-\r\n");
+		}
+	}
+	for (i = 0; journal_Get(i, &data); i++) {
+		debug.printf("J%d. ", i);
+		PrintHistoryData(data);
+	}
+	debug.printf("--------------------------------------------\r\n");
+}
+
+static void PrintDuration(uint32_t seconds) {
+	debug.printf(" %02d:%02d", (int) (seconds / 3600),
+			(int) (seconds / 60 % 60));
+}
+
+// Pump and link time as hh:mm, temperatures as min/mean/max
+static void PrintRollup(const rollup_t *rollup) {
+	TimeStruct_t time;
 	uint8_t i;
-	for (i = 0; i < MAX_NUMBER_OF_HISTORIES; i++) {
-		debug.printf("%d. ", i);
-		PrintHistoryData(m_EEPROM_Array.Payload.Item.data[i]);
-		if (i == m_currentIndex) {
-			debug.printf("--------------------------------------------\r\n");
+
+	clock_ToTime(rollup->start, &time);
+	PrintTime(&time);
+	PrintDuration(rollup->collectorPump);
+	PrintDuration(rollup->boilerPump);
+	PrintDuration(rollup->link);
+	for (i = 0; i < ROLLUP_TEMPS; i++) {
+		if (rollup->valid & (1 << i)) {
+			debug.printf(", %d/%d/%dC", rollup->min[i], rollup->mean[i],
+					rollup->max[i]);
+		} else {
+			debug.printf(", -");
 		}
 	}
+	debug.printf("\r\n");
 }
 
-void LoadParameters(void) {
-	if (at24c_read()) {
-		m_currentIndex = m_EEPROM_Array.Payload.Item.currentIndex;
-		m_deltaPlus = m_EEPROM_Array.Payload.Item.deltaPlus;
-		m_deltaMinus = m_EEPROM_Array.Payload.Item.deltaMinus;
-	} else {
-		m_currentIndex = 0;
-		m_deltaPlus = 3;
-		m_deltaMinus = 1;
+static void PrintRollupPeriod(uint8_t period, uint16_t count) {
+	rollup_t rollup;
+	uint16_t age;
+
+	for (age = 0; age < count; age++) {
+		if (rollup_Get(period, age, &rollup)) {
+			PrintRollup(&rollup);
+		}
+	}
+}
+
+// Every hour and day kept, newest first, one read each
+void PrintRollups(void) {
+	debug.printf("Pumps collector, boiler, link, collector, water heater, "
+			"boiler\r\n");
+	debug.printf("Hours:\r\n");
+	PrintRollupPeriod(ROLLUP_HOUR, ROLLUP_HOURS);
+	debug.printf("Days:\r\n");
+	PrintRollupPeriod(ROLLUP_DAY, ROLLUP_DAYS);
+	debug.printf("--------------------------------------------\r\n");
+}
+
+// Called every second
+void SampleRollups(void) {
+	historyData_t data;
+	uint8_t valid = 0;
+
+	GetCurrentData(&data);
+	if (data.status.bits.nRFComm && TemperatureIsValid(data.tempCollector)) {
+		valid |= 1 << 0;
+	}
+	if (TemperatureIsValid(data.tempWaterHeater)) {
+		valid |= 1 << 1;
+	}
+	if (TemperatureIsValid(data.tempBoiler)) {
+		valid |= 1 << 2;
 	}
+	rollup_Sample(&data, valid);
+}
+
+void LoadParameters(void) {
+	uint32_t start = micros;
+
+	config_Mount();
+	history_Mount();
+	journal_Replay();
+	rollup_Mount(clock_Now());
+
+	m_deltaPlus = config_Get(CONFIG_DELTA_PLUS);
+	m_deltaMinus = config_Get(CONFIG_DELTA_MINUS);
+	debug.printf("LoadParameters: %u us\r\n", (unsigned int) (micros - start));
 	PrintHistory();
 	PrintDelta();
 }
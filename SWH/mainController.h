@@ -20,6 +20,8 @@ extern uint8_t m_collectorPump;
 void InitWaterPump(void);
 void WaterPumpController(void);
 void PrintHistory(void);
+void PrintRollups(void);
+void SampleRollups(void);
 void LoadParameters(void);
 
 void IncreaseDeltaPlus(void);
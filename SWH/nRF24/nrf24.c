@@ -1,5 +1,6 @@
 // Functions to manage the nRF24L01+ transceiver
 
+#include <string.h>
 #include "nrf24.h"
 #include "defines.h"
 #include "debugUsart.h"
@@ -27,19 +28,20 @@ nrf24_error_t nRF24_Init(void) {
 
 /* configure the module */
 void nRF24_Config(nrf24_t* ctxNRF24) {
+	uint8_t pipe;
+
 	/* Use static payload length ... */
 	NRF24PayloadSize = ctxNRF24->PayloadSize;
 
 	// Set RF channel
 	NRF24ConfigRegister(RF_CH, ctxNRF24->Channel);
 
-	// Set length of incoming payload
-	NRF24ConfigRegister(RX_PW_P0, 0x00); // Auto-ACK pipe ...
-	NRF24ConfigRegister(RX_PW_P1, ctxNRF24->PayloadSize); // Data payload pipe
-	NRF24ConfigRegister(RX_PW_P2, 0x00); // Pipe not used
-	NRF24ConfigRegister(RX_PW_P3, 0x00); // Pipe not used
-	NRF24ConfigRegister(RX_PW_P4, 0x00); // Pipe not used
-	NRF24ConfigRegister(RX_PW_P5, 0x00); // Pipe not used
+	// Set length of incoming payload, 0 for pipes not used
+	// Pipe 0 is the Auto-ACK pipe when it's not a data pipe
+	for (pipe = 0; pipe < NRF24_PIPES; pipe++) {
+		NRF24ConfigRegister(RX_PW_P0 + pipe,
+				(ctxNRF24->Pipes & (1 << pipe)) ? ctxNRF24->PayloadSize : 0x00);
+	}
 
 	// 1 Mbps, TX gain: 0dbm
 	NRF24ConfigRegister(RF_SETUP, (0 << RF_DR) | ((0x03) << RF_PWR));
@@ -48,22 +50,22 @@ void nRF24_Config(nrf24_t* ctxNRF24) {
 	NRF24ConfigRegister(CONFIG, NRF24_CONFIG);
 
 	// Auto Acknowledgment
-	NRF24ConfigRegister(EN_AA,
-			(1 << ENAA_P0) | (1 << ENAA_P1) | (0 << ENAA_P2) | (0 << ENAA_P3) | (0 << ENAA_P4)
-					| (0 << ENAA_P5));
+	NRF24ConfigRegister(EN_AA, (1 << ENAA_P0) | ctxNRF24->Pipes);
 
 	// Enable RX addresses
-	NRF24ConfigRegister(EN_RXADDR,
-			(1 << ERX_P0) | (1 << ERX_P1) | (0 << ERX_P2) | (0 << ERX_P3) | (0 << ERX_P4)
-					| (0 << ERX_P5));
+	NRF24ConfigRegister(EN_RXADDR, (1 << ERX_P0) | ctxNRF24->Pipes);
 
 	// Auto retransmit delay: 1000 us and Up to 15 retransmit trials
 	NRF24ConfigRegister(SETUP_RETR, (0x04 << ARD) | (0x0F << ARC));
 
-	// Dynamic length configurations: No dynamic length
-	NRF24ConfigRegister(DYNPD,
-			(0 << DPL_P0) | (0 << DPL_P1) | (0 << DPL_P2) | (0 << DPL_P3) | (0 << DPL_P4)
-					| (0 << DPL_P5));
+	// Dynamic length configurations, pipe 0 too for the Auto-ACK
+	if (ctxNRF24->DynamicPayload) {
+		NRF24ConfigRegister(FEATURE, (1 << EN_DPL));
+		NRF24ConfigRegister(DYNPD, (1 << DPL_P0) | ctxNRF24->Pipes);
+	} else {
+		NRF24ConfigRegister(FEATURE, 0x00);
+		NRF24ConfigRegister(DYNPD, 0x00);
+	}
 
 	// Start listening
 	NRF24PowerUpRx();
@@ -98,6 +100,15 @@ void NRF24SetRxAddress(nrf24_t* ctxNRF24) {
 	NRF24ChipEnable(HIGH);
 }
 
+/* Set the RX address of a pipe, pipes 2 to 5 take only the first (least
+ * significant) byte, the rest is the address of pipe 1 */
+void NRF24SetPipeAddress(uint8_t Pipe, const uint8_t* Address) {
+	NRF24ChipEnable(LOW);
+	NRF24WriteRegister(RX_ADDR_P0 + Pipe, (uint8_t*) Address,
+			Pipe < 2 ? NRF24_ADDR_LEN : 1);
+	NRF24ChipEnable(HIGH);
+}
+
 /* Returns the payload length */
 uint8_t NRF24TxPayloadLength(void) {
 	return NRF24PayloadSize;
@@ -136,27 +147,30 @@ uint8_t NRF24RxFifoEmpty(void) {
 
 /* Returns the length of data waiting in the RX fifo */
 uint8_t NRF24RxPayloadLength(void) {
-	uint8_t status;
-	NRF24ChipSelect(LOW);
-	spi_transfer(R_RX_PL_WID);
-	status = spi_transfer(0x00);
-	NRF24ChipSelect(HIGH);
-	return status;
+	uint8_t length;
+	NRF24Command(R_RX_PL_WID, NULL, &length, 1);
+	return length;
 }
 
 /* Reads payload bytes into data array */
 void NRF24GetData(nrf24_t* ctxNRF24) {
-	/* Pull down chip select */
-	NRF24ChipSelect(LOW);
+	uint8_t length = ctxNRF24->PayloadSize;
 
-	/* Send cmd to read rx payload */
-	spi_transfer(R_RX_PAYLOAD);
+	if (ctxNRF24->DynamicPayload) {
+		length = NRF24RxPayloadLength();
 
-	/* Read payload */
-	NRF24ReceiveBuffer(ctxNRF24->RXData, ctxNRF24->PayloadSize);
+		/* Longer than 32 bytes is a corrupt payload, it must be flushed */
+		if (length > NRF24_MAX_PAYLOAD) {
+			NRF24Command(FLUSH_RX, NULL, NULL, 0);
+			length = 0;
+		}
+	}
+	ctxNRF24->RXLength = length;
 
-	/* Pull up chip select */
-	NRF24ChipSelect(HIGH);
+	/* Send cmd to read rx payload and read payload */
+	if (length) {
+		NRF24Command(R_RX_PAYLOAD, NULL, ctxNRF24->RXData, length);
+	}
 
 	/* Reset status register */
 	NRF24ConfigRegister(STATUS, (1 << RX_DR));
@@ -181,27 +195,13 @@ void NRF24Send(nrf24_t* ctxNRF24) {
 
 	/* Do we really need to flush TX fifo each time ? */
 #if 1
-	/* Pull down chip select */
-	NRF24ChipSelect(LOW);
-
 	/* Write cmd to flush transmit FIFO */
-	spi_transfer(FLUSH_TX);
-
-	/* Pull up chip select */
-	NRF24ChipSelect(HIGH);
+	NRF24Command(FLUSH_TX, NULL, NULL, 0);
 #endif
 
-	/* Pull down chip select */
-	NRF24ChipSelect(LOW);
-
-	/* Write cmd to write payload */
-	spi_transfer(W_TX_PAYLOAD);
-
-	/* Write payload */
-	NRF24TransmitBuffer(ctxNRF24->TXData, ctxNRF24->PayloadSize);
-
-	/* Pull up chip select */
-	NRF24ChipSelect(HIGH);
+	/* Write cmd to write payload and write payload */
+	NRF24Command(W_TX_PAYLOAD, ctxNRF24->TXData, NULL,
+			ctxNRF24->DynamicPayload ? ctxNRF24->TXLength : ctxNRF24->PayloadSize);
 
 	/* Start the transmission */
 	NRF24ChipEnable(HIGH);
@@ -222,11 +222,7 @@ uint8_t NRF24IsSending(void) {
 }
 
 uint8_t NRF24GetStatus(void) {
-	uint8_t rv;
-	NRF24ChipSelect(LOW);
-	rv = spi_transfer(NOP);
-	NRF24ChipSelect(HIGH);
-	return rv;
+	return NRF24Command(NOP, NULL, NULL, 0);
 }
 
 uint8_t NRF24LastMessageStatus(void) {
@@ -250,9 +246,7 @@ uint8_t NRF24LastMessageStatus(void) {
 }
 
 void NRF24PowerUpRx(void) {
-	NRF24ChipSelect(LOW);
-	spi_transfer(FLUSH_RX);
-	NRF24ChipSelect(HIGH);
+	NRF24Command(FLUSH_RX, NULL, NULL, 0);
 
 	NRF24ConfigRegister(STATUS, (1 << RX_DR) | (1 << TX_DS) | (1 << MAX_RT));
 
@@ -273,44 +267,47 @@ void NRF24PowerDown(void) {
 
 /* send and receive multiple bytes over SPI */
 void NRF24ReceiveBuffer(uint8_t* DataIn, uint8_t Len) {
-	uint8_t i;
-
-	for (i = 0; i < Len; i++) {
-		DataIn[i] = spi_transfer(0xff);
-	}
+	spi_xfer(NULL, DataIn, Len);
 }
 
 /* send multiple bytes over SPI */
 void NRF24TransmitBuffer(uint8_t* Data, uint8_t Len) {
-	uint8_t i;
+	spi_xfer(Data, NULL, Len);
+}
+
+/* One chip select frame: command, then Len bytes from Tx (NOP if NULL)
+ * while Len bytes go to Rx (dropped if NULL), returns STATUS */
+uint8_t NRF24Command(uint8_t Cmd, const uint8_t* Tx, uint8_t* Rx, uint8_t Len) {
+	uint8_t frame[1 + NRF24_MAX_PAYLOAD];
+
+	frame[0] = Cmd;
+	if (Tx) {
+		memcpy(&frame[1], Tx, Len);
+	} else {
+		memset(&frame[1], NOP, Len);
+	}
 
-	for (i = 0; i < Len; i++) {
-		spi_transfer(Data[i]);
+	spi_frame(frame, frame, 1 + Len);
+
+	if (Rx) {
+		memcpy(Rx, &frame[1], Len);
 	}
+	return frame[0];
 }
 
 /* Clocks only one byte into the given NRF24 register */
 void NRF24ConfigRegister(uint8_t Address, uint8_t Value) {
-	NRF24ChipSelect(LOW);
-	spi_transfer(W_REGISTER | (REGISTER_MASK & Address));
-	spi_transfer(Value);
-	NRF24ChipSelect(HIGH);
+	NRF24Command(W_REGISTER | (REGISTER_MASK & Address), &Value, NULL, 1);
 }
 
 /* Read single register from NRF24 */
 void NRF24ReadRegister(uint8_t Address, uint8_t* Data, uint8_t Len) {
-	NRF24ChipSelect(LOW);
-	spi_transfer(R_REGISTER | (REGISTER_MASK & Address));
-	NRF24ReceiveBuffer(Data, Len);
-	NRF24ChipSelect(HIGH);
+	NRF24Command(R_REGISTER | (REGISTER_MASK & Address), NULL, Data, Len);
 }
 
 /* Write to a single register of nrf24 */
 void NRF24WriteRegister(uint8_t Address, uint8_t* Data, uint8_t Len) {
-	NRF24ChipSelect(LOW);
-	spi_transfer(W_REGISTER | (REGISTER_MASK & Address));
-	NRF24TransmitBuffer(Data, Len);
-	NRF24ChipSelect(HIGH);
+	NRF24Command(W_REGISTER | (REGISTER_MASK & Address), Data, NULL, Len);
 }
 
 // Print nRF24L01+ current configuration (for debug purposes)
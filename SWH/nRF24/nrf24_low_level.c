@@ -14,11 +14,28 @@
 #include <stm32f10x_gpio.h>
 #include <stm32f10x_rcc.h>
 #include <stm32f10x_spi.h>
+#include <stm32f10x_dma.h>
+#include <stm32f10x_exti.h>
+#include <misc.h>
 
 #include "nrf24_low_level.h"
+#include "defines.h"
 #include "debugUsart.h"
 #include "systemTicks.h"
 
+// Set by the IRQ pin going low, signals the receive task
+volatile unsigned char m_nRF24Irq;
+
+// Transfer running on DMA, and what to call when it's done
+static volatile uint8_t m_spiBusy;
+static uint8_t m_spiAsync;
+static spiCallback_t *m_spiDone;
+// Source and sink of a DMA transfer without a buffer on that side
+static const uint8_t m_spiDummyTx = SPI_DUMMY;
+static uint8_t m_spiDummyRx;
+
+static void spi_DMA_Init(void);
+
 // Configure the GPIO lines of the nRF24L01 transceiver
 // note: IRQ pin must be configured separately
 void nRF24_GPIO_Init(void) {
@@ -53,6 +70,49 @@ void nRF24_GPIO_Init(void) {
 	GPIO_Init(GPIOC, &PORT);
 }
 
+/**
+ * This funcion connects the IRQ pin to EXTI line 0.
+ * IRQ is active low, it goes low when RX_DR, TX_DS or MAX_RT is set
+ * and stays low until they are cleared, so the falling edge is used.
+ */
+void nRF24_IRQ_Init(void) {
+	EXTI_InitTypeDef EXTI_InitStructure;
+	NVIC_InitTypeDef NVIC_InitStructure;
+
+	GPIO_EXTILineConfig(nRF24_IRQ_PORT_SOURCE, nRF24_IRQ_PIN_SOURCE);
+
+	EXTI_InitStructure.EXTI_Line = nRF24_IRQ_EXTI_LINE;
+	EXTI_InitStructure.EXTI_Mode = EXTI_Mode_Interrupt;
+	EXTI_InitStructure.EXTI_Trigger = EXTI_Trigger_Falling;
+	EXTI_InitStructure.EXTI_LineCmd = ENABLE;
+	EXTI_Init(&EXTI_InitStructure);
+	EXTI_ClearITPendingBit(nRF24_IRQ_EXTI_LINE);
+
+	NVIC_InitStructure.NVIC_IRQChannel = EXTI0_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * This funcion returns true while the IRQ pin is low.
+ */
+uint8_t nRF24_IRQ_Asserted(void) {
+	return !(nRF24_IRQ_PORT->IDR & nRF24_IRQ_PIN);
+}
+
+/*----------------------------------------------------------------------------
+ EXTI0_IRQHandler
+ Handles the nRF24 IRQ pin, the SPI work is left to the receive task.
+ *----------------------------------------------------------------------------*/
+void EXTI0_IRQHandler(void) {
+	if (EXTI_GetITStatus(nRF24_IRQ_EXTI_LINE) != RESET) {
+		EXTI_ClearITPendingBit(nRF24_IRQ_EXTI_LINE);
+		m_nRF24Irq = true;
+	}
+}
+
 /**
  * This funcion initializes the SPI1 peripheral.
  * Setup SPI1 pins A4/SS, A5/SCK, A6/MISO, A7/MOSI on port A.
@@ -91,6 +151,8 @@ void Init_SPI1_Master(void) {
 	SPI_Init(nRF24_SPI_PORT, &SPI);
 	SPI_NSSInternalSoftwareConfig(nRF24_SPI_PORT, SPI_NSSInternalSoft_Set);
 	SPI_Cmd(nRF24_SPI_PORT, ENABLE);
+
+	spi_DMA_Init();
 }
 
 /**
@@ -130,6 +192,8 @@ void Init_SPI2_Master(void) {
 	SPI_Init(nRF24_SPI_PORT, &SPI);
 	SPI_NSSInternalSoftwareConfig(nRF24_SPI_PORT, SPI_NSSInternalSoft_Set);
 	SPI_Cmd(nRF24_SPI_PORT, ENABLE);
+
+	spi_DMA_Init();
 }
 
 /**
@@ -178,3 +242,173 @@ uint8_t spi_transfer(uint8_t tx) {
 	return rx_data;
 }
 
+/**
+ * This funcion enables the DMA channels of the SPI port and the interrupt
+ * of the RX channel.
+ */
+static void spi_DMA_Init(void) {
+	NVIC_InitTypeDef NVIC_InitStructure;
+
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+
+	NVIC_InitStructure.NVIC_IRQChannel = nRF24_DMA_RX_IRQn;
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	m_spiBusy = false;
+	m_spiAsync = false;
+}
+
+/**
+ * Polled transfer, the next byte is written while the one before is
+ * still shifting out, so the clock doesn't stop between bytes.
+ * rx may be tx, a byte is received after the one after it is sent.
+ */
+static void spi_xfer_polled(const uint8_t *tx, uint8_t *rx, uint16_t len) {
+	uint16_t i;
+	uint8_t data;
+
+	nRF24_SPI_PORT->DR = tx ? tx[0] : SPI_DUMMY;
+	for (i = 0; i < len; i++) {
+		if (i + 1 < len) {
+			while (!(nRF24_SPI_PORT->SR & SPI_SR_TXE)) {
+				;
+			}
+			nRF24_SPI_PORT->DR = tx ? tx[i + 1] : SPI_DUMMY;
+		}
+		while (!(nRF24_SPI_PORT->SR & SPI_SR_RXNE)) {
+			;
+		}
+		data = nRF24_SPI_PORT->DR;
+		if (rx) {
+			rx[i] = data;
+		}
+	}
+	while (nRF24_SPI_PORT->SR & SPI_SR_BSY) {
+		;
+	}
+}
+
+/**
+ * Starts a DMA transfer, the RX channel interrupt ends it.
+ * RX has the higher priority so a received byte is taken before the
+ * next one comes in.
+ */
+static void spi_xfer_dma(const uint8_t *tx, uint8_t *rx, uint16_t len) {
+	DMA_InitTypeDef DMA;
+
+	m_spiBusy = true;
+
+	DMA.DMA_PeripheralBaseAddr = (uint32_t) &nRF24_SPI_PORT->DR;
+	DMA.DMA_BufferSize = len;
+	DMA.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+	DMA.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+	DMA.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+	DMA.DMA_Mode = DMA_Mode_Normal;
+	DMA.DMA_M2M = DMA_M2M_Disable;
+
+	DMA.DMA_MemoryBaseAddr = (uint32_t) (rx ? rx : &m_spiDummyRx);
+	DMA.DMA_MemoryInc = rx ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+	DMA.DMA_DIR = DMA_DIR_PeripheralSRC;
+	DMA.DMA_Priority = DMA_Priority_VeryHigh;
+	DMA_Init(nRF24_DMA_RX_CHANNEL, &DMA);
+
+	DMA.DMA_MemoryBaseAddr = (uint32_t) (tx ? tx : &m_spiDummyTx);
+	DMA.DMA_MemoryInc = tx ? DMA_MemoryInc_Enable : DMA_MemoryInc_Disable;
+	DMA.DMA_DIR = DMA_DIR_PeripheralDST;
+	DMA.DMA_Priority = DMA_Priority_High;
+	DMA_Init(nRF24_DMA_TX_CHANNEL, &DMA);
+
+	DMA_ITConfig(nRF24_DMA_RX_CHANNEL, DMA_IT_TC, ENABLE);
+	DMA_Cmd(nRF24_DMA_RX_CHANNEL, ENABLE);
+	DMA_Cmd(nRF24_DMA_TX_CHANNEL, ENABLE);
+	SPI_I2S_DMACmd(nRF24_SPI_PORT, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx,
+			ENABLE);
+}
+
+/**
+ * Buffer level SPI transmit/receive, chip select is left to the caller
+ * input:
+ *   tx - bytes to transmit, NULL sends SPI_DUMMY
+ *   rx - received bytes, NULL drops them, may be tx
+ *   len - number of bytes
+ */
+void spi_xfer(const uint8_t *tx, uint8_t *rx, uint16_t len) {
+	while (m_spiBusy) {
+		;
+	}
+	if (len == 0) {
+		return;
+	}
+	if (len > SPI_DMA_THRESHOLD) {
+		spi_xfer_dma(tx, rx, len);
+		while (m_spiBusy) {
+			;
+		}
+	} else {
+		spi_xfer_polled(tx, rx, len);
+	}
+}
+
+/**
+ * Same as spi_xfer, in one chip select frame
+ */
+void spi_frame(const uint8_t *tx, uint8_t *rx, uint16_t len) {
+	while (m_spiBusy) {
+		;
+	}
+	GPIO_ResetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+	spi_xfer(tx, rx, len);
+	GPIO_SetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+}
+
+/**
+ * One chip select frame on DMA, returns at once. Chip select goes high
+ * and done is called from the DMA interrupt, the buffers must live until
+ * then. Returns false if a transfer is still running.
+ */
+uint8_t spi_frame_async(const uint8_t *tx, uint8_t *rx, uint16_t len,
+		spiCallback_t *done) {
+	if (m_spiBusy || len == 0) {
+		return false;
+	}
+	m_spiAsync = true;
+	m_spiDone = done;
+	GPIO_ResetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+	spi_xfer_dma(tx, rx, len);
+	return true;
+}
+
+uint8_t spi_busy(void) {
+	return m_spiBusy;
+}
+
+/*----------------------------------------------------------------------------
+ nRF24_DMA_IRQHandler
+ The last byte is in when the RX channel is done, the clock has stopped.
+ *----------------------------------------------------------------------------*/
+void nRF24_DMA_IRQHandler(void) {
+	spiCallback_t *done = m_spiDone;
+
+	if (DMA_GetITStatus(nRF24_DMA_RX_IT_TC) != RESET) {
+		DMA_ClearITPendingBit(nRF24_DMA_RX_IT_GL);
+
+		SPI_I2S_DMACmd(nRF24_SPI_PORT, SPI_I2S_DMAReq_Rx | SPI_I2S_DMAReq_Tx,
+				DISABLE);
+		DMA_Cmd(nRF24_DMA_TX_CHANNEL, DISABLE);
+		DMA_Cmd(nRF24_DMA_RX_CHANNEL, DISABLE);
+
+		// the frame of spi_frame_async ends here, the others in the caller
+		if (m_spiAsync) {
+			GPIO_SetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+			m_spiAsync = false;
+			m_spiDone = NULL;
+		}
+		m_spiBusy = false;
+		if (done) {
+			done();
+		}
+	}
+}
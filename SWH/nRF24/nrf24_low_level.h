@@ -37,6 +37,29 @@
 #define nRF24_CSN_PIN              GPIO_Pin_12
 #endif
 
+// DMA channels of the SPI port, the RX channel interrupt ends a transfer
+#ifdef USE_SPI1
+#define nRF24_DMA_RX_CHANNEL       DMA1_Channel2
+#define nRF24_DMA_TX_CHANNEL       DMA1_Channel3
+#define nRF24_DMA_RX_IRQn          DMA1_Channel2_IRQn
+#define nRF24_DMA_RX_IT_TC         DMA1_IT_TC2
+#define nRF24_DMA_RX_IT_GL         DMA1_IT_GL2
+#define nRF24_DMA_IRQHandler       DMA1_Channel2_IRQHandler
+#else
+#define nRF24_DMA_RX_CHANNEL       DMA1_Channel4
+#define nRF24_DMA_TX_CHANNEL       DMA1_Channel5
+#define nRF24_DMA_RX_IRQn          DMA1_Channel4_IRQn
+#define nRF24_DMA_RX_IT_TC         DMA1_IT_TC4
+#define nRF24_DMA_RX_IT_GL         DMA1_IT_GL4
+#define nRF24_DMA_IRQHandler       DMA1_Channel4_IRQHandler
+#endif
+
+// Transfers longer than this go through DMA, shorter ones are polled,
+// setting up the two channels costs about as much as a few bytes
+#define SPI_DMA_THRESHOLD          8
+// Clocked out when there is nothing to send, NOP for the nRF24
+#define SPI_DUMMY                  0xFF
+
 // CE (chip enable)
 #define nRF24_CE_PORT              GPIOB
 #define nRF24_CE_PIN               GPIO_Pin_1
@@ -44,14 +67,30 @@
 // IRQ pin
 #define nRF24_IRQ_PORT             GPIOB
 #define nRF24_IRQ_PIN              GPIO_Pin_0
+#define nRF24_IRQ_PORT_SOURCE      GPIO_PortSourceGPIOB
+#define nRF24_IRQ_PIN_SOURCE       GPIO_PinSource0
+#define nRF24_IRQ_EXTI_LINE        EXTI_Line0
+
+extern volatile unsigned char m_nRF24Irq;
 
 //function prototypes
 void nRF24_GPIO_Init(void);
 void Init_SPI1_Master(void);
 void Init_SPI2_Master(void);
+void nRF24_IRQ_Init(void);
+uint8_t nRF24_IRQ_Asserted(void);
 
 void ToggleLedInd(void);
 uint8_t spi_transfer(uint8_t data);
 
+// Called from the DMA interrupt when an asynchronous transfer is done
+typedef void (spiCallback_t)(void);
+
+void spi_xfer(const uint8_t *tx, uint8_t *rx, uint16_t len);
+void spi_frame(const uint8_t *tx, uint8_t *rx, uint16_t len);
+uint8_t spi_frame_async(const uint8_t *tx, uint8_t *rx, uint16_t len,
+		spiCallback_t *done);
+uint8_t spi_busy(void);
+
 #endif	/* __NRF24_LOW_LEVEL_H */
 
@@ -15,6 +15,7 @@
 #include "nrf24_mid_level.h"
 #include "nrf24_low_level.h"
 #include "nrf24.h"
+#include "packet.h"
 #include "ds1820.h"
 #include "debugUsart.h"
 #include "ds1307_mid_level.h"
@@ -25,13 +26,35 @@ nrf24_t NRF24Ctx = {
 		.RXAddress = { 0xD7, 0xD7, 0xD7, 0xD7, 0xD7 },
 		.TXAddress = { 0xE7, 0xE7, 0xE7, 0xE7, 0xE7 },
 		.PayloadSize = 2,
-		.Channel = 2
+		.Channel = 2,
+		.Pipes = (1 << NRF24_PIPES) - 1,
+		.DynamicPayload = true
 };
 
-twoBytes m_tCollector;
-nrf24Data_t nrf24Data;
+// First address byte of each pipe, the others are RXAddress. Pipe 1 keeps
+// the whole RXAddress, so the STC as it is now is the node on pipe 1.
+static const uint8_t m_nRF24PipeAddress[NRF24_PIPES] = { 0xD0, 0xD7, 0xD2,
+		0xD3, 0xD4, 0xD5 };
+
+nrf24Node_t nrf24Nodes[NRF24_NODES];
+
+// Payloads that couldn't be read, or named a node that isn't there
+static uint16_t m_nRF24Rejected;
+
+static void nRF24_SetPipeAddresses(void) {
+	uint8_t address[NRF24_ADDR_LEN];
+	uint8_t pipe;
+
+	memcpy(address, NRF24Ctx.RXAddress, NRF24_ADDR_LEN);
+	for (pipe = 0; pipe < NRF24_PIPES; pipe++) {
+		address[0] = m_nRF24PipeAddress[pipe];
+		NRF24SetPipeAddress(pipe, address);
+	}
+}
 
 void nRF24_Initialize(void) {
+	uint8_t node;
+
 	nRF24_GPIO_Init();
 #ifdef USE_SPI1
 	Init_SPI1_Master();
@@ -50,31 +73,182 @@ void nRF24_Initialize(void) {
 
 	nRF24_Config(&NRF24Ctx);
 
-	NRF24SetRxAddress(&NRF24Ctx);
-	NRF24SetTxAddress(&NRF24Ctx);
+	// Only receives, pipe 0 is a data pipe and TX_ADDR isn't used
+	nRF24_SetPipeAddresses();
+
+	memset(nrf24Nodes, 0, sizeof(nrf24Nodes));
+	for (node = 0; node < NRF24_NODES; node++) {
+		nrf24Nodes[node].period = NRF24_NODE_PERIOD;
+		nrf24Nodes[node].timeout = NRF24_NODE_TIMEOUT;
+		nrf24Nodes[node].windowStart = micros;
+	}
 
-	nrf24Data.connected = false;
+	// STATUS was cleared by the configuration, IRQ is high
+	nRF24_IRQ_Init();
 }
 
+// Payload from pipe into the state of its node
+static void nRF24_Process(uint8_t pipe, const uint8_t *payload, uint8_t len) {
+	packet_t packet;
+	nrf24Node_t *node;
+	int16_t battery;
+	uint8_t id, gap, taken;
+
+	if (packet_Decode(payload, len, &packet) != PACKET_OK) {
+		m_nRF24Rejected++;
+		return;
+	}
+	id = packet.version == PACKET_LEGACY_VERSION ? pipe : packet.node;
+	if (id >= NRF24_NODES) {
+		m_nRF24Rejected++;
+		return;
+	}
+	node = &nrf24Nodes[id];
+
+	// Sequence goes on unless the node was reset, a packet that isn't
+	// newer is the same one again, its ACK got lost
+	if (packet.version != PACKET_LEGACY_VERSION) {
+		gap = packet.sequence - node->sequence;
+		if (node->received && node->version != PACKET_LEGACY_VERSION
+				&& !(packet.status & PACKET_STATUS_BOOT)) {
+			if (gap == 0 || gap > 0x80) {
+				node->duplicates++;
+				return;
+			}
+			node->lost += gap - 1;
+		}
+		node->sequence = packet.sequence;
+	}
+	node->version = packet.version;
+	node->status = packet.status;
+
+	// Every temperature sensor by its index and the battery, the rest is a
+	// sensor of a newer minor version or past NRF24_NODE_SENSORS
+	taken = packet_Values(&packet, PACKET_TEMPERATURE, node->temperature,
+			NRF24_NODE_SENSORS);
+	battery = node->battery;
+	taken += packet_Values(&packet, PACKET_BATTERY, &battery, 1);
+	node->battery = battery;
+	node->unknown += packet.count - taken;
+
+	node->connected = true;
+	node->lastSeen = micros;
+	node->received++;
+	if (node->windowCount < NRF24_QUALITY_PERIODS) {
+		node->windowCount++;
+	}
+}
+
+// Signalled by the IRQ pin, reads every payload in the RX FIFO
 void nRF24_Receive(void) {
-	if (NRF24DataReady()) {
-		ToggleLedInd();
+	uint8_t packets, pipe;
+
+	// RX_DR is cleared after each payload, one that arrives meanwhile
+	// pulls IRQ low again. STATUS has the pipe of the payload at the
+	// top of the FIFO, 7 when it's empty.
+	for (packets = 0; packets < NRF24_RX_FIFO_DEPTH; packets++) {
+		pipe = (NRF24GetStatus() >> RX_P_NO) & 0x07;
+		if (pipe >= NRF24_PIPES) {
+			break;
+		}
 		NRF24GetData(&NRF24Ctx);
-//		debug.printf("Received data:\r\n");
+		nRF24_Process(pipe, NRF24Ctx.RXData, NRF24Ctx.RXLength);
+	}
+
+	if (packets) {
+		ToggleLedInd();
+	}
+}
 
-		m_tCollector.b[0] = NRF24Ctx.RXData[0];
-		m_tCollector.b[1] = NRF24Ctx.RXData[1];
+// Timeout and quality of each node, and an edge lost while the receive
+// task ran: the scheduler clears the signal after the task, IRQ stays low
+// and no edge follows
+void nRF24_CheckLink(void) {
+	nrf24Node_t *node;
+	uint8_t i;
 
-//		if (m_setTimeState == TIME_SET_NONE) {
-//			for (uint8_t i = 0; i < NRF24Ctx.PayloadSize; i++) {
-//				debug.printf("%2X ", NRF24Ctx.RXData[i]);
-//			}
-//			debug.printf("\r\n");
-//			DebugMoveCursorUp(1);
-//		}
+	if (nRF24_IRQ_Asserted()) {
+		m_nRF24Irq = true;
+	}
 
-		nrf24Data.connected = true;
-		nrf24Data.timeout = micros;
+	for (i = 0; i < NRF24_NODES; i++) {
+		node = &nrf24Nodes[i];
+		if (node->connected && TIMEOUT(node->lastSeen, node->timeout)) {
+			node->connected = false;
+		}
+		if (TIMEOUT(node->windowStart, node->period * NRF24_QUALITY_PERIODS)) {
+			node->quality = node->windowCount * 100 / NRF24_QUALITY_PERIODS;
+			node->windowCount = 0;
+			node->windowStart = micros;
+		}
 	}
 }
 
+void nRF24_PrintNodes(void) {
+	nrf24Node_t *node;
+	uint8_t i;
+
+	for (i = 0; i < NRF24_NODES; i++) {
+		node = &nrf24Nodes[i];
+		if (!node->received) {
+			continue;
+		}
+		debug.printf("Node %u: %d, %s, %u%%, %u payloads, %u s ago\r\n", i,
+				node->temperature[0], node->connected ? "+" : "-",
+				node->quality, node->received,
+				(micros - node->lastSeen) / 1000000);
+		debug.printf("  %d %d %d, %u mV\r\n", node->temperature[1],
+				node->temperature[2], node->temperature[3], node->battery);
+		debug.printf("  v%02X, status %02X, %u lost, %u again, %u unknown\r\n",
+				node->version, node->status, node->lost, node->duplicates,
+				node->unknown);
+	}
+	debug.printf("Rejected: %u\r\n", m_nRF24Rejected);
+}
+
+static volatile uint8_t m_spiBenchDone;
+
+static void nRF24_BenchmarkDone(void) {
+	m_spiBenchDone = true;
+}
+
+// Cycles of SPI frames of NOPs, one byte at a time and on spi_frame, the
+// raw clock is 8 bits times the SPI prescaler
+void nRF24_Benchmark(void) {
+	static uint8_t frame[1 + NRF24_MAX_PAYLOAD];
+	uint8_t lengths[2] = { SPI_DMA_THRESHOLD, sizeof(frame) };
+	uint32_t start, single, buffer, async;
+	uint8_t i, n;
+
+	memset(frame, NOP, sizeof(frame));
+	InitCycleCounter();
+
+	for (n = 0; n < 2; n++) {
+		start = CYCLES();
+		GPIO_ResetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+		for (i = 0; i < lengths[n]; i++) {
+			spi_transfer(frame[i]);
+		}
+		GPIO_SetBits(nRF24_CSN_PORT, nRF24_CSN_PIN);
+		single = CYCLES() - start;
+
+		start = CYCLES();
+		spi_frame(frame, frame, lengths[n]);
+		buffer = CYCLES() - start;
+
+		debug.printf("SPI %u bytes: %u, %u cycles per byte (%s)\r\n",
+				lengths[n], single / lengths[n], buffer / lengths[n],
+				lengths[n] > SPI_DMA_THRESHOLD ? "DMA" : "polled");
+	}
+
+	// CPU time of a DMA frame, the rest of it is free
+	m_spiBenchDone = false;
+	start = CYCLES();
+	spi_frame_async(frame, frame, sizeof(frame), &nRF24_BenchmarkDone);
+	async = CYCLES() - start;
+	while (!m_spiBenchDone) {
+		;
+	}
+	debug.printf("SPI %u bytes async: %u cycles to start\r\n", (unsigned) sizeof(frame),
+			async);
+}
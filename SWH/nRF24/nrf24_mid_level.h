@@ -16,18 +16,53 @@
 
 #include "defines.h"
 
-#define NRF24_TIMEOUT		10000000
+// Payloads the RX FIFO holds
+#define NRF24_RX_FIFO_DEPTH	3
+
+// A node before the header is the one on its pipe, the collector STC is on
+// pipe 1 as before. A packet with a header names its node, nodes share the
+// pipes then and there can be more of them than pipes.
+#define NRF24_NODES				16
+#define NRF24_NODE_COLLECTOR	1
+
+// Sensors of each kind a node keeps, by index, a reading of a higher index
+// is counted as not kept
+#define NRF24_NODE_SENSORS		4
+
+// Payload period and timeout of a node, in us, the STC sends every 2 s
+#define NRF24_NODE_PERIOD		2000000
+#define NRF24_NODE_TIMEOUT		10000000
+
+// Quality is the share of the payloads expected in this many periods that
+// came, a late or early payload moves it by one step only
+#define NRF24_QUALITY_PERIODS	8
 
 typedef struct {
+	int16_t temperature[NRF24_NODE_SENSORS];	// last of each sensor
 	uint8_t connected;
-	uint32_t timeout;
-} nrf24Data_t;
+	uint8_t quality;		// percent, see NRF24_QUALITY_PERIODS
+	uint32_t lastSeen;		// micros at the last payload
+	uint32_t period;		// node sends every period us
+	uint32_t timeout;		// not connected after timeout us without a payload
+	uint32_t received;		// payloads since boot
+	uint32_t windowStart;	// micros the quality window started at
+	uint8_t windowCount;	// payloads in the window
+	uint8_t version;		// of the last packet, 0 before the header
+	uint8_t sequence;		// of the last packet
+	uint8_t status;			// PACKET_STATUS_* of the last packet
+	uint16_t battery;		// mV, 0 if the node doesn't send it
+	uint16_t lost;			// packets missing from the sequence
+	uint16_t duplicates;	// packets seen before, or older than the last
+	uint16_t unknown;		// readings of a sensor that isn't kept
+} nrf24Node_t;
 
-extern nrf24Data_t nrf24Data;
-extern twoBytes m_tCollector;
+extern nrf24Node_t nrf24Nodes[NRF24_NODES];
 
 void nRF24_Initialize(void);
 void nRF24_Receive(void);
+void nRF24_CheckLink(void);
+void nRF24_PrintNodes(void);
+void nRF24_Benchmark(void);
 
 #endif	/* __NRF24_MID_LEVEL_H */
 
@@ -0,0 +1,86 @@
+/**
+ ******************************************************************************
+ * @file		packet.h
+ * @author		Milan Rakic
+ * @date		19 October 2026
+ ******************************************************************************
+ */
+
+#ifndef __PACKET_H
+#define __PACKET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Includes ---------------------------------------------------------------- */
+#include "stm32f10x.h"
+
+/** Defines ----------------------------------------------------------------- */
+// Major version in the high nibble, a packet of another major version
+// isn't read. Minor version in the low nibble, a newer minor version only
+// adds sensors, the ones not known are skipped.
+#define PACKET_VERSION				0x10
+#define PACKET_MAJOR(_version)		((_version) >> 4)
+
+// Version, node, sequence and status
+#define PACKET_HEADER_SIZE			4
+// Sensor and value, little endian
+#define PACKET_READING_SIZE			3
+#define PACKET_MAX_SIZE				32
+#define PACKET_MAX_READINGS			((PACKET_MAX_SIZE - PACKET_HEADER_SIZE) \
+											/ PACKET_READING_SIZE)
+
+// Payload of the STC before the header, the collector temperature only
+#define PACKET_LEGACY_SIZE			2
+#define PACKET_LEGACY_VERSION		0
+
+// Sensors, the low nibble is the index of the sensor of that kind
+#define PACKET_TEMPERATURE			0x00	// degrees C
+#define PACKET_BATTERY				0x10	// mV
+#define PACKET_KIND(_sensor)		((_sensor) & 0xF0)
+#define PACKET_INDEX(_sensor)		((_sensor) & 0x0F)
+
+// Status bits
+#define PACKET_STATUS_BOOT			0x01	// first packet since reset
+#define PACKET_STATUS_SENSOR		0x02	// a sensor didn't answer
+#define PACKET_STATUS_BATTERY		0x04	// battery low
+
+typedef enum {
+	PACKET_OK = 0,
+	PACKET_TOO_SHORT,		// shorter than the header
+	PACKET_WRONG_VERSION,	// major version not known
+	PACKET_BAD_LENGTH		// readings don't fill the payload
+} packetError_t;
+
+typedef struct {
+	uint8_t sensor;
+	int16_t value;
+} packetReading_t;
+
+typedef struct {
+	uint8_t version;
+	uint8_t node;
+	uint8_t sequence;		// one more for every packet, wraps
+	uint8_t status;
+	uint8_t count;
+	packetReading_t readings[PACKET_MAX_READINGS];
+} packet_t;
+
+/** Public function prototypes ---------------------------------------------- */
+void packet_Init(packet_t *packet, uint8_t node, uint8_t sequence,
+		uint8_t status);
+uint8_t packet_Add(packet_t *packet, uint8_t sensor, int16_t value);
+uint8_t packet_Encode(const packet_t *packet, uint8_t *out);
+packetError_t packet_Decode(const uint8_t *in, uint8_t len, packet_t *packet);
+uint8_t packet_Values(const packet_t *packet, uint8_t kind, int16_t *values,
+		uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* __PACKET_H */
+
+/********************************* END OF FILE ********************************/
+/******************************************************************************/
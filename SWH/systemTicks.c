@@ -16,6 +16,12 @@ void InitSystemTicks(void) {
     Systick_Init();
 }
 
+void InitCycleCounter(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
 void SysTick_Handler(void) {
     micros++;
 }
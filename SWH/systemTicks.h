@@ -11,8 +11,12 @@
 
 #define _DelayMS(x)        _DelayUS(x * 1000)
 
+// DWT cycle counter, used for benchmarking
+#define CYCLES()           (DWT->CYCCNT)
+
 extern volatile uint32_t micros;
 void InitSystemTicks(void);
+void InitCycleCounter(void);
 
 extern void _DelayUS(uint32_t aDelay);
 
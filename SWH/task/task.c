@@ -25,7 +25,7 @@ void InitTasks(void) {
 	currentNumberOfTasks = 0;
 }
 
-unsigned char AddTaskSignal(pTask_t *aTask, unsigned char *aTrigger, uint8_t aEnable) {
+unsigned char AddTaskSignal(pTask_t *aTask, volatile unsigned char *aTrigger, uint8_t aEnable) {
 	if (currentNumberOfTasks < NUMBER_OF_TASKS) {
 		if (aTask != NULL) {
 			task[currentNumberOfTasks].pTask = aTask;
@@ -21,7 +21,7 @@
 typedef void pTask_t(void);
 
 typedef struct {
-	unsigned char *pTrigger;
+	volatile unsigned char *pTrigger;
 	unsigned suspend :1;
 	uint32_t RunTimeCnt;
 	uint32_t TimeOut;
@@ -38,7 +38,7 @@ extern unsigned char currentNumberOfTasks;
 
 //function prototypes
 void InitTasks(void);
-unsigned char AddTaskSignal(pTask_t *aTask, unsigned char *aTrigger, uint8_t aEnable);
+unsigned char AddTaskSignal(pTask_t *aTask, volatile unsigned char *aTrigger, uint8_t aEnable);
 unsigned char AddTaskTime(pTask_t *aTask, uint32_t aTime, uint8_t aEnable);
 void SetTaskEnabled(task_t *aTask, unsigned char aEnable);
 void SetTaskEnabled_Func(pTask_t *aFunc, uint8_t aEnable);